@@ -0,0 +1,87 @@
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/image_clahe.cpp  Tests CLAHE on images whose size is not a multiple of the tile count.
+*   \test  Tests CLAHE on images whose size is not a multiple of the tile count.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+//
+// *** ViennaCV
+//
+#include "viennacv/core/image_histogram.hpp"
+
+
+/** @brief Without clipping, a uniform image maps to a uniform image whatever the tiling, since every tile has the same distribution. Trailing tiles
+ *  left empty by the tile size rounding used to blend all-zero tables into the last rows and columns. */
+template<typename NumericT>
+int test_uniform(std::size_t size1, std::size_t size2, NumericT value)
+{
+  viennacl::matrix<NumericT> image(size1, size2), result;
+  std::vector<std::vector<NumericT> > host(size1, std::vector<NumericT>(size2, value));
+  viennacl::copy(host, image);
+
+  viennacv::clahe(image, result, 0.0, 8, 8);
+  viennacl::copy(result, host);
+
+  NumericT lo = host[0][0], hi = host[0][0];
+  for (std::size_t i = 0; i < size1; ++i)
+    for (std::size_t j = 0; j < size2; ++j)
+    {
+      lo = std::min(lo, host[i][j]);
+      hi = std::max(hi, host[i][j]);
+    }
+  if (lo != hi)
+  {
+    std::cout << "# Error at operation: clahe of a uniform " << size1 << " x " << size2 << " image" << std::endl;
+    std::cout << "  output range: " << double(lo) << " .. " << double(hi) << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: CLAHE tiling" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::size_t sizes[] = {1, 7, 10, 13, 17, 50, 64, 100};
+  for (std::size_t size1 : sizes)
+    for (std::size_t size2 : sizes)
+    {
+      if (test_uniform<unsigned char>(size1, size2, 128) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+      if (test_uniform<float>(size1, size2, 0.5f) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/image_wrapped_buffer.cpp  Tests that in-place filters of images wrapping a host buffer write their result to that buffer.
+*   \test  Tests that in-place filters of images wrapping a host buffer write their result to that buffer.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+//
+// *** ViennaCV
+//
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_filter.hpp"
+
+
+/** @brief Compare every pixel of the wrapped buffer with the expected value */
+template<typename NumericT>
+int check_buffer(std::string const & operation, std::vector<NumericT> const & buffer, NumericT expected)
+{
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+    if (std::fabs(double(buffer[i]) - double(expected)) > 1e-4)
+    {
+      std::cout << "# Error at operation: " << operation << std::endl;
+      std::cout << "  buffer[" << i << "] = " << double(buffer[i]) << ", expected " << double(expected) << std::endl;
+      return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+/** @brief A non-separable 3x3 kernel whose taps sum to 32, applied in place with replicated border to a uniform image wrapping a host buffer. Every
+ *  pixel is multiplied by 32, and the buffer itself must hold the result after each application. */
+template<typename NumericT>
+int test_filter_apply(std::size_t size1, std::size_t size2)
+{
+  std::vector<NumericT> buffer(size1 * size2, NumericT(1));
+  viennacv::image_colpre<NumericT> image(buffer.data(), 1, size1, size2);
+
+  viennacl::matrix<NumericT> kernel(3, 3);
+  kernel.clear();
+  kernel(0, 0) = NumericT(8); kernel(1, 1) = NumericT(16); kernel(2, 1) = NumericT(8);   // rank 2
+  viennacv::convolution_filter<NumericT> filter(kernel, std::vector<std::pair<std::size_t, std::size_t> >(), viennacv::BORDER_REPLICATE);
+
+  NumericT expected = NumericT(1);
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    filter.apply(image);
+    expected *= NumericT(32);
+    if (check_buffer("convolution_filter::apply(image) pass " + std::to_string(pass), buffer, expected) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief The in-place median of a channel wrapping a host buffer, compared pixel by pixel with the out-of-place median. */
+template<typename NumericT>
+int test_median(std::size_t size1, std::size_t size2)
+{
+  std::vector<NumericT> buffer(size1 * size2);
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = NumericT((i * 37) % 101);
+  viennacv::image_colpre<NumericT> image(buffer.data(), 1, size1, size2);
+
+  viennacl::matrix<NumericT> reference;
+  viennacv::filter::median(image.data_[0], 1, reference);
+  viennacv::filter::median(image.data_[0], 1, image.data_[0]);
+
+  for (std::size_t i = 0; i < size1; ++i)
+    for (std::size_t j = 0; j < size2; ++j)
+      if (buffer[i * size2 + j] != NumericT(reference(i, j)))
+      {
+        std::cout << "# Error at operation: in-place median of a wrapped " << size1 << " x " << size2 << " buffer" << std::endl;
+        std::cout << "  pixel (" << i << ", " << j << ") = " << double(buffer[i * size2 + j]) << ", expected " << double(reference(i, j)) << std::endl;
+        return EXIT_FAILURE;
+      }
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: In-place filters on wrapped buffers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  // 128 columns need no row padding, 7 columns do
+  if (test_filter_apply<float>(128, 128) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_filter_apply<float>(5, 7) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_median<float>(5, 7) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_median<unsigned char>(5, 7) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,672 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_CONVOLUTION_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_CONVOLUTION_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/linalg/host_based/convolution_operations.hpp
+    @brief Implementations of dense 2D image convolution using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+// Minimum Matrix size(size1*size2) for using OpenMP on convolution:
+#ifndef VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE
+  #define VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE  5000
+#endif
+
+// Output tile size of the cache-blocked convolution. A tile row of accumulators stays in L1, the input rows of a tile plus its halo stay in L2.
+#ifndef VIENNACL_CONVOLUTION_TILE_ROWS
+  #define VIENNACL_CONVOLUTION_TILE_ROWS  32
+#endif
+#ifndef VIENNACL_CONVOLUTION_TILE_COLS
+  #define VIENNACL_CONVOLUTION_TILE_COLS  256
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Extension of a convolution input beyond its edges, shown for the row abcd and a halo of two */
+enum convolution_border
+{
+  CONVOLUTION_BORDER_CONSTANT    = 0,   // vv|abcd|vv, v a given value
+  CONVOLUTION_BORDER_REPLICATE   = 1,   // aa|abcd|dd
+  CONVOLUTION_BORDER_REFLECT     = 2,   // ba|abcd|dc
+  CONVOLUTION_BORDER_REFLECT_101 = 3,   // cb|abcd|cb
+  CONVOLUTION_BORDER_WRAP        = 4    // cd|abcd|ab
+};
+
+namespace detail
+{
+
+/** @brief Location of the entries of a (possibly strided or column-major) dense matrix: entry (i, j) lives at data[offset + i * row_pitch + j * col_pitch]. */
+struct matrix_pitches
+{
+  vcl_size_t offset;
+  vcl_size_t row_pitch;
+  vcl_size_t col_pitch;
+};
+
+template<typename NumericT>
+matrix_pitches extract_pitches(matrix_base<NumericT> const & A)
+{
+  matrix_pitches p;
+  if (A.row_major())
+  {
+    p.offset    = viennacl::traits::start1(A) * viennacl::traits::internal_size2(A) + viennacl::traits::start2(A);
+    p.row_pitch = viennacl::traits::stride1(A) * viennacl::traits::internal_size2(A);
+    p.col_pitch = viennacl::traits::stride2(A);
+  }
+  else
+  {
+    p.offset    = viennacl::traits::start1(A) + viennacl::traits::start2(A) * viennacl::traits::internal_size1(A);
+    p.row_pitch = viennacl::traits::stride1(A);
+    p.col_pitch = viennacl::traits::stride2(A) * viennacl::traits::internal_size1(A);
+  }
+  return p;
+}
+
+/** @brief A single non-zero kernel entry: out(i, j) += weight * in(i + row_bias, j + col_bias) */
+template<typename NumericT>
+struct convolution_tap
+{
+  long     row_bias;
+  long     col_bias;
+  NumericT weight;
+};
+
+/** @brief Conversion with clamping to the range of the destination type, and rounding to nearest if the destination is integral. */
+template<typename DestNumericT, typename SrcNumericT>
+inline DestNumericT saturate_cast(SrcNumericT value)
+{
+  if constexpr (std::is_integral<DestNumericT>::value && std::is_floating_point<SrcNumericT>::value)
+  {
+    double v = std::floor(double(value) + 0.5);
+    if (v <= double(std::numeric_limits<DestNumericT>::lowest())) return std::numeric_limits<DestNumericT>::lowest();
+    if (v >= double(std::numeric_limits<DestNumericT>::max()))    return std::numeric_limits<DestNumericT>::max();
+    return static_cast<DestNumericT>(v);
+  }
+  else if constexpr (std::is_integral<DestNumericT>::value)
+  {
+    long long v = static_cast<long long>(value);
+    if (v < static_cast<long long>(std::numeric_limits<DestNumericT>::lowest())) return std::numeric_limits<DestNumericT>::lowest();
+    if (v > static_cast<long long>(std::numeric_limits<DestNumericT>::max()))    return std::numeric_limits<DestNumericT>::max();
+    return static_cast<DestNumericT>(v);
+  }
+  else
+    return static_cast<DestNumericT>(value);
+}
+
+/** @brief Placement of the output on the input and extension of the input beyond its edges:
+*   out(i, j) = sum_k weight_k * in(i + row_offset + row_bias_k, j + col_offset + col_bias_k),
+*   the input entries outside of the edges being given by the border mode. The default is the same-size output with zero border. */
+struct convolution_geometry
+{
+  long   row_offset   = 0;
+  long   col_offset   = 0;
+  int    border       = CONVOLUTION_BORDER_CONSTANT;
+  double border_value = 0;    // Input value outside of the edges for CONVOLUTION_BORDER_CONSTANT
+};
+
+/** @brief Index inside [0, n) that the index i outside of the edges reads for a (non-constant) border mode, any distance from the edges being allowed */
+inline long border_index(long i, long n, int border)
+{
+  if (i >= 0 && i < n)
+    return i;
+  switch (border)
+  {
+  case CONVOLUTION_BORDER_REPLICATE:
+    return std::min(std::max(i, 0L), n - 1);
+  case CONVOLUTION_BORDER_REFLECT:
+  {
+    long m = ((i % (2 * n)) + 2 * n) % (2 * n);
+    return (m < n) ? m : 2 * n - 1 - m;
+  }
+  case CONVOLUTION_BORDER_REFLECT_101:
+  {
+    if (n == 1)
+      return 0;
+    long m = ((i % (2 * n - 2)) + 2 * n - 2) % (2 * n - 2);
+    return (m < n) ? m : 2 * n - 2 - m;
+  }
+  default:
+    return ((i % n) + n) % n;
+  }
+}
+
+/** @brief Accumulate one tap into the accumulators of the output columns [col_begin, col_end) of one output row.
+*
+* The columns reading inside of the input row are a single branch-free multiply-add loop the compiler vectorizes. Only the columns reading beyond
+* the edges, at most the kernel half width per side, go through the border mode.
+*
+* @param acc           Accumulators of the output columns, acc[0] for col_begin
+* @param src_row       First entry of the input row
+* @param col_pitch     Distance of neighbouring entries of the input row
+* @param col_shift     Input column minus output column, col_offset + col_bias of the tap
+* @param size2         Length of the input row
+*/
+template<typename InNumericT, typename AccumT>
+inline void accumulate_tap(AccumT * acc, InNumericT const * src_row, vcl_size_t col_pitch,
+                           long col_begin, long col_end, long col_shift, long size2,
+                           AccumT weight, int border, AccumT border_value)
+{
+  long lo = std::min(std::max(-col_shift, col_begin), col_end);
+  long hi = std::min(std::max(size2 - col_shift, lo), col_end);
+  if (lo < hi)
+  {
+    InNumericT const * src = src_row + vcl_size_t(lo + col_shift) * col_pitch;
+    AccumT           * dst = acc + (lo - col_begin);
+    long               len = hi - lo;
+    if (col_pitch == 1)
+      for (long j = 0; j < len; ++j)
+        dst[j] += weight * AccumT(src[j]);
+    else
+      for (long j = 0; j < len; ++j)
+        dst[j] += weight * AccumT(src[vcl_size_t(j) * col_pitch]);
+  }
+
+  // border strips [col_begin, lo) and [hi, col_end)
+  if (border == CONVOLUTION_BORDER_CONSTANT)
+  {
+    if (border_value == AccumT(0))
+      return;
+    for (long col = col_begin; col < lo; ++col)
+      acc[col - col_begin] += weight * border_value;
+    for (long col = hi; col < col_end; ++col)
+      acc[col - col_begin] += weight * border_value;
+  }
+  else
+  {
+    for (long col = col_begin; col < lo; ++col)
+      acc[col - col_begin] += weight * AccumT(src_row[vcl_size_t(border_index(col + col_shift, size2, border)) * col_pitch]);
+    for (long col = hi; col < col_end; ++col)
+      acc[col - col_begin] += weight * AccumT(src_row[vcl_size_t(border_index(col + col_shift, size2, border)) * col_pitch]);
+  }
+}
+
+/** @brief Accumulate all taps into the accumulators of the output columns [col_begin, col_end) of one output row, see convolve(). Input rows beyond the
+*  edges are mapped once per tap by the border mode, or contribute the constant border value. */
+template<typename InNumericT, typename WeightT, typename AccumT>
+inline void accumulate_row(AccumT * acc, InNumericT const * data_in, matrix_pitches const & p_in, long size1, long size2,
+                           std::vector<convolution_tap<WeightT> > const & taps, long row, long col_begin, long col_end,
+                           convolution_geometry const & geometry, AccumT border_value)
+{
+  for (vcl_size_t k = 0; k < taps.size(); ++k)
+  {
+    AccumT weight  = AccumT(taps[k].weight);
+    long   src_row = row + geometry.row_offset + taps[k].row_bias;
+    if (src_row < 0 || src_row >= size1)
+    {
+      if (geometry.border == CONVOLUTION_BORDER_CONSTANT)
+      {
+        if (border_value != AccumT(0))
+          for (long j = 0; j < col_end - col_begin; ++j)
+            acc[j] += weight * border_value;
+        continue;
+      }
+      src_row = border_index(src_row, size1, geometry.border);
+    }
+    accumulate_tap(acc, data_in + p_in.offset + vcl_size_t(src_row) * p_in.row_pitch, p_in.col_pitch,
+                   col_begin, col_end, geometry.col_offset + taps[k].col_bias, size2, weight, geometry.border, border_value);
+  }
+}
+
+} //namespace detail
+
+//
+// Introductory note: By convention, all dimensions are already checked in the dispatcher frontend. No need to double-check again in here!
+//
+
+/** @brief Cache-blocked direct 2D convolution (correlation form).
+*
+* The output is processed in tiles of VIENNACL_CONVOLUTION_TILE_ROWS x VIENNACL_CONVOLUTION_TILE_COLS. Every output row of a tile accumulates all taps in a local buffer before it is written once,
+* so the input is streamed from cache instead of once per tap from memory. Borders are handled by splitting the column range per tap and row into the part reading
+* inside of the input, a plain vectorizable loop, and the thin strips beyond the edges, see detail::accumulate_tap(), rather than by a test per pixel.
+*
+* @param in         Input matrix, must not share memory with out
+* @param taps       Non-zero kernel entries with their offsets relative to the output pixel
+* @param out        Output matrix, of the same size as in unless the geometry moves the output window
+* @param row_begin  First output row to compute, e.g. of a row band of a pipeline
+* @param row_end    Output row after the last one to compute, clamped to size1(out)
+* @param geometry   Output window and border mode, a same-size output with zero border by default
+*/
+template<typename NumericT>
+void convolve(matrix_base<NumericT> const & in,
+              std::vector<detail::convolution_tap<NumericT> > const & taps,
+              matrix_base<NumericT> & out,
+              vcl_size_t row_begin = 0,
+              vcl_size_t row_end = vcl_size_t(-1),
+              detail::convolution_geometry const & geometry = detail::convolution_geometry())
+{
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+  detail::matrix_pitches p_in  = detail::extract_pitches(in);
+  detail::matrix_pitches p_out = detail::extract_pitches(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  NumericT border_value = NumericT(geometry.border_value);
+
+  long const tile_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long const tile_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long row_first = static_cast<long>(std::min<vcl_size_t>(row_begin, vcl_size_t(out_size1)));
+  long row_last  = static_cast<long>(std::min<vcl_size_t>(row_end, vcl_size_t(out_size1)));
+  long tile_num1 = (std::max(row_last - row_first, 0L) + tile_rows - 1) / tile_rows;
+  long tile_num2 = (out_size2 + tile_cols - 1) / tile_cols;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long tile = 0; tile < tile_num1 * tile_num2; ++tile)
+  {
+    NumericT acc[VIENNACL_CONVOLUTION_TILE_COLS];
+
+    long tile_row_begin = row_first + (tile / tile_num2) * tile_rows;
+    long tile_row_end   = std::min(tile_row_begin + tile_rows, row_last);
+    long col_begin = (tile % tile_num2) * tile_cols;
+    long col_end   = std::min(col_begin + tile_cols, out_size2);
+
+    for (long row = tile_row_begin; row < tile_row_end; ++row)
+    {
+      std::fill(acc, acc + (col_end - col_begin), NumericT(0));
+      detail::accumulate_row(acc, data_in, p_in, size1, size2, taps, row, col_begin, col_end, geometry, border_value);
+
+      NumericT * dst = data_out + p_out.offset + vcl_size_t(row) * p_out.row_pitch + vcl_size_t(col_begin) * p_out.col_pitch;
+      for (long j = 0; j < col_end - col_begin; ++j)
+        dst[vcl_size_t(j) * p_out.col_pitch] = acc[j];
+    }
+  }
+}
+
+/** @brief Cache-blocked direct 2D convolution for integer pixels with fixed-point taps and a wide integer accumulator.
+*
+* Same tiling and border handling as convolve(). Pixels are widened to AccumT only inside the accumulation, every output is
+* rounded by an arithmetic shift of 'shift' fraction bits and saturated to OutNumericT. With shift = 0 the taps are plain integers.
+*
+* @param in         Input matrix, must not share memory with out
+* @param taps       Non-zero kernel entries, weights given in fixed point with 'shift' fraction bits
+* @param out        Output matrix, of the same size as in unless the geometry moves the output window
+* @param shift      Number of fraction bits of the tap weights
+* @param row_begin  First output row to compute
+* @param row_end    Output row after the last one to compute, clamped to size1(out)
+* @param geometry   Output window and border mode. The constant border value is rounded to AccumT, in the units of the input.
+*/
+template<typename InNumericT, typename AccumT, typename OutNumericT>
+void convolve_fixed_point(matrix_base<InNumericT> const & in,
+                          std::vector<detail::convolution_tap<AccumT> > const & taps,
+                          matrix_base<OutNumericT> & out,
+                          unsigned int shift,
+                          vcl_size_t row_begin = 0,
+                          vcl_size_t row_end = vcl_size_t(-1),
+                          detail::convolution_geometry const & geometry = detail::convolution_geometry())
+{
+  InNumericT const * data_in  = detail::extract_raw_pointer<InNumericT>(in);
+  OutNumericT      * data_out = detail::extract_raw_pointer<OutNumericT>(out);
+
+  detail::matrix_pitches p_in  = detail::extract_pitches(in);
+  detail::matrix_pitches p_out = detail::extract_pitches(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  AccumT border_value = AccumT(std::llround(geometry.border_value));
+
+  long const tile_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long const tile_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long row_first = static_cast<long>(std::min<vcl_size_t>(row_begin, vcl_size_t(out_size1)));
+  long row_last  = static_cast<long>(std::min<vcl_size_t>(row_end, vcl_size_t(out_size1)));
+  long tile_num1 = (std::max(row_last - row_first, 0L) + tile_rows - 1) / tile_rows;
+  long tile_num2 = (out_size2 + tile_cols - 1) / tile_cols;
+  AccumT rounding = shift ? (AccumT(1) << (shift - 1)) : AccumT(0);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long tile = 0; tile < tile_num1 * tile_num2; ++tile)
+  {
+    AccumT acc[VIENNACL_CONVOLUTION_TILE_COLS];
+
+    long tile_row_begin = row_first + (tile / tile_num2) * tile_rows;
+    long tile_row_end   = std::min(tile_row_begin + tile_rows, row_last);
+    long col_begin = (tile % tile_num2) * tile_cols;
+    long col_end   = std::min(col_begin + tile_cols, out_size2);
+
+    for (long row = tile_row_begin; row < tile_row_end; ++row)
+    {
+      std::fill(acc, acc + (col_end - col_begin), rounding);
+      detail::accumulate_row(acc, data_in, p_in, size1, size2, taps, row, col_begin, col_end, geometry, border_value);
+
+      OutNumericT * dst = data_out + p_out.offset + vcl_size_t(row) * p_out.row_pitch + vcl_size_t(col_begin) * p_out.col_pitch;
+      for (long j = 0; j < col_end - col_begin; ++j)
+        dst[vcl_size_t(j) * p_out.col_pitch] = detail::saturate_cast<OutNumericT>(acc[j] >> shift);
+    }
+  }
+}
+
+/** @brief Cache-blocked direct 2D convolution of a batch of same-sized images by one kernel in a single parallel loop.
+*
+* The work items are all tiles of all images, so a batch of small images (e.g. 64x64 patches) keeps every thread busy
+* where one call per image would only have a single tile to share. Every row goes through the same detail::accumulate_row() as convolve(),
+* so output window and border mode behave as for one image at a time.
+* Floating point weights accumulate in WeightT, integer weights are fixed point with 'shift' fraction bits as in convolve_fixed_point().
+*
+* @param in        Input images, all of the same size
+* @param taps      Non-zero kernel entries with their offsets relative to the output pixel
+* @param out       Output images, all of the same size, must not share memory with any input image
+* @param shift     Number of fraction bits of integer tap weights, ignored for floating point weights
+* @param geometry  Output window and border mode, a same-size output with zero border by default. For integer weights the constant border value is rounded to WeightT.
+*/
+template<typename InNumericT, typename WeightT, typename OutNumericT>
+void convolve_batched(std::vector<matrix_base<InNumericT> const *> const & in,
+                      std::vector<detail::convolution_tap<WeightT> > const & taps,
+                      std::vector<matrix_base<OutNumericT> *> const & out,
+                      unsigned int shift = 0,
+                      detail::convolution_geometry const & geometry = detail::convolution_geometry())
+{
+  long batch = static_cast<long>(in.size());
+  if (batch == 0)
+    return;
+
+  std::vector<InNumericT const *>      data_in(in.size());
+  std::vector<OutNumericT *>           data_out(in.size());
+  std::vector<detail::matrix_pitches>  p_in(in.size()), p_out(in.size());
+  for (vcl_size_t b = 0; b < in.size(); ++b)
+  {
+    data_in[b]  = detail::extract_raw_pointer<InNumericT>(*in[b]);
+    data_out[b] = detail::extract_raw_pointer<OutNumericT>(*out[b]);
+    p_in[b]     = detail::extract_pitches(*in[b]);
+    p_out[b]    = detail::extract_pitches(*out[b]);
+  }
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*in[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*in[0]));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(*out[0]));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(*out[0]));
+
+  long const tile_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long const tile_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long tile_num1 = (out_size1 + tile_rows - 1) / tile_rows;
+  long tile_num2 = (out_size2 + tile_cols - 1) / tile_cols;
+  long tile_num  = tile_num1 * tile_num2;
+  WeightT rounding = WeightT(0);
+  WeightT border_value = WeightT(geometry.border_value);
+  if constexpr (std::is_integral<WeightT>::value)
+  {
+    rounding = shift ? (WeightT(1) << (shift - 1)) : WeightT(0);
+    border_value = WeightT(std::llround(geometry.border_value));
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((batch*out_size1*out_size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long item = 0; item < batch * tile_num; ++item)
+  {
+    WeightT acc[VIENNACL_CONVOLUTION_TILE_COLS];
+
+    vcl_size_t                   b    = vcl_size_t(item / tile_num);
+    long                         tile = item % tile_num;
+    detail::matrix_pitches const & po = p_out[b];
+
+    long row_begin = (tile / tile_num2) * tile_rows;
+    long row_end   = std::min(row_begin + tile_rows, out_size1);
+    long col_begin = (tile % tile_num2) * tile_cols;
+    long col_end   = std::min(col_begin + tile_cols, out_size2);
+
+    for (long row = row_begin; row < row_end; ++row)
+    {
+      std::fill(acc, acc + (col_end - col_begin), rounding);
+      detail::accumulate_row(acc, data_in[b], p_in[b], size1, size2, taps, row, col_begin, col_end, geometry, border_value);
+
+      OutNumericT * dst = data_out[b] + po.offset + vcl_size_t(row) * po.row_pitch + vcl_size_t(col_begin) * po.col_pitch;
+      for (long j = 0; j < col_end - col_begin; ++j)
+      {
+        if constexpr (std::is_integral<WeightT>::value)
+          dst[vcl_size_t(j) * po.col_pitch] = detail::saturate_cast<OutNumericT>(acc[j] >> shift);
+        else
+          dst[vcl_size_t(j) * po.col_pitch] = detail::saturate_cast<OutNumericT>(acc[j]);
+      }
+    }
+  }
+}
+
+/** @brief Recursive gaussian filter (Young - van Vliet) with a cost per pixel independent of sigma.
+*
+* A causal and an anti-causal third order IIR pass are run along every row and then along every column.
+* Rows are distributed over threads, the column pass updates a block of VIENNACL_CONVOLUTION_TILE_COLS adjacent columns per row so that memory is walked row by row.
+* The recursions are started from the steady state of the border pixel, i.e. the border is treated as replicated.
+*
+* @param in     Input matrix, may be the same object as out
+* @param sigma  Standard deviation of the gaussian, clamped to the valid range sigma >= 0.5 of the coefficient fit
+* @param out    Output matrix of the same size as in
+*/
+template<typename NumericT>
+void recursive_gaussian(matrix_base<NumericT> const & in,
+                        NumericT sigma,
+                        matrix_base<NumericT> & out)
+{
+  double s = std::max(double(sigma), 0.5);
+  double q = (s >= 2.5) ? 0.98711 * s - 0.96330 : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * s);
+  double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+  NumericT c1 = NumericT(( 2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q) / b0);
+  NumericT c2 = NumericT(-(1.4281 * q * q + 1.26661 * q * q * q) / b0);
+  NumericT c3 = NumericT(( 0.422205 * q * q * q) / b0);
+  NumericT B  = NumericT(1) - (c1 + c2 + c3);
+
+  NumericT const * data_in  = detail::extract_raw_pointer<NumericT>(in);
+  NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
+
+  detail::matrix_pitches p_in  = detail::extract_pitches(in);
+  detail::matrix_pitches p_out = detail::extract_pitches(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  if (size1 == 0 || size2 == 0)
+    return;
+
+  // row pass, in -> out
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * src = data_in  + p_in.offset  + vcl_size_t(row) * p_in.row_pitch;
+    NumericT       * dst = data_out + p_out.offset + vcl_size_t(row) * p_out.row_pitch;
+    vcl_size_t si = p_in.col_pitch, di = p_out.col_pitch;
+
+    NumericT w1 = src[0], w2 = w1, w3 = w1;
+    for (long j = 0; j < size2; ++j)
+    {
+      NumericT w0 = B * src[vcl_size_t(j) * si] + c1 * w1 + c2 * w2 + c3 * w3;
+      dst[vcl_size_t(j) * di] = w0;
+      w3 = w2; w2 = w1; w1 = w0;
+    }
+    w1 = dst[vcl_size_t(size2 - 1) * di]; w2 = w1; w3 = w1;
+    for (long j = size2 - 1; j >= 0; --j)
+    {
+      NumericT w0 = B * dst[vcl_size_t(j) * di] + c1 * w1 + c2 * w2 + c3 * w3;
+      dst[vcl_size_t(j) * di] = w0;
+      w3 = w2; w2 = w1; w1 = w0;
+    }
+  }
+
+  // column pass, out -> out in place
+  long const block_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long block_num = (size2 + block_cols - 1) / block_cols;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long block = 0; block < block_num; ++block)
+  {
+    NumericT w1[VIENNACL_CONVOLUTION_TILE_COLS], w2[VIENNACL_CONVOLUTION_TILE_COLS], w3[VIENNACL_CONVOLUTION_TILE_COLS];
+    long col_begin = block * block_cols;
+    long len = std::min(col_begin + block_cols, size2) - col_begin;
+    NumericT * base = data_out + p_out.offset + vcl_size_t(col_begin) * p_out.col_pitch;
+    vcl_size_t di = p_out.col_pitch;
+
+    for (long j = 0; j < len; ++j)
+      w1[j] = w2[j] = w3[j] = base[vcl_size_t(j) * di];
+    for (long row = 0; row < size1; ++row)
+    {
+      NumericT * dst = base + vcl_size_t(row) * p_out.row_pitch;
+      for (long j = 0; j < len; ++j)
+      {
+        NumericT w0 = B * dst[vcl_size_t(j) * di] + c1 * w1[j] + c2 * w2[j] + c3 * w3[j];
+        dst[vcl_size_t(j) * di] = w0;
+        w3[j] = w2[j]; w2[j] = w1[j]; w1[j] = w0;
+      }
+    }
+
+    NumericT * last = base + vcl_size_t(size1 - 1) * p_out.row_pitch;
+    for (long j = 0; j < len; ++j)
+      w1[j] = w2[j] = w3[j] = last[vcl_size_t(j) * di];
+    for (long row = size1 - 1; row >= 0; --row)
+    {
+      NumericT * dst = base + vcl_size_t(row) * p_out.row_pitch;
+      for (long j = 0; j < len; ++j)
+      {
+        NumericT w0 = B * dst[vcl_size_t(j) * di] + c1 * w1[j] + c2 * w2[j] + c3 * w3[j];
+        dst[vcl_size_t(j) * di] = w0;
+        w3[j] = w2[j]; w2[j] = w1[j]; w1[j] = w0;
+      }
+    }
+  }
+}
+
+/** @brief Fused 3x3 Sobel operator producing the x and y derivatives, the gradient magnitude and the gradient orientation in one read of the input.
+*
+* Sobel is separable, so every row is first smoothed ([1 2 1]) and differenced ([1 0 -1]) vertically into two line buffers, and the horizontal
+* difference/smoothing is taken from those buffers. Pixels outside of the input are zero, matching convolve(). The x derivative is in(i, j+1) - in(i, j-1)
+* and the y derivative is in(i-1, j) - in(i+1, j) (y axis pointing up), both smoothed. Rows are processed in blocks distributed over threads.
+*
+* @param in                Input matrix
+* @param gx                x derivative, or NULL
+* @param gy                y derivative, or NULL
+* @param magnitude         sqrt(gx^2 + gy^2), or NULL
+* @param orientation       Gradient orientation, or NULL. atan2(gy, gx) in radians if orientation_bins is 0, otherwise the index of the
+*                          nearest of the directions 0, 45, 90, 135 degrees (gradient sign ignored) if orientation_bins is 4
+* @param orientation_bins  0 or 4, see orientation
+* @param row_begin         First output row to compute
+* @param row_end           Output row after the last one to compute, clamped to size1(in)
+*/
+template<typename InNumericT, typename OutNumericT>
+void sobel_gradient(matrix_base<InNumericT> const & in,
+                    matrix_base<OutNumericT> * gx,
+                    matrix_base<OutNumericT> * gy,
+                    matrix_base<OutNumericT> * magnitude,
+                    matrix_base<OutNumericT> * orientation,
+                    unsigned int orientation_bins = 0,
+                    vcl_size_t row_begin = 0,
+                    vcl_size_t row_end = vcl_size_t(-1))
+{
+  typedef typename std::conditional<std::is_integral<OutNumericT>::value, double, OutNumericT>::type WorkT;
+
+  InNumericT const * data_in = detail::extract_raw_pointer<InNumericT>(in);
+  detail::matrix_pitches p_in = detail::extract_pitches(in);
+
+  OutNumericT * data_out[4] = { NULL, NULL, NULL, NULL };
+  detail::matrix_pitches p_out[4];
+  matrix_base<OutNumericT> * outputs[4] = { gx, gy, magnitude, orientation };
+  for (int k = 0; k < 4; ++k)
+    if (outputs[k])
+    {
+      data_out[k] = detail::extract_raw_pointer<OutNumericT>(*outputs[k]);
+      p_out[k]    = detail::extract_pitches(*outputs[k]);
+    }
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long row_first = static_cast<long>(std::min<vcl_size_t>(row_begin, vcl_size_t(size1)));
+  long row_last  = static_cast<long>(std::min<vcl_size_t>(row_end, vcl_size_t(size1)));
+  long const block_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long block_num = (std::max(row_last - row_first, 0L) + block_rows - 1) / block_rows;
+  WorkT const tan_22_5 = WorkT(0.41421356237309503);
+  WorkT const tan_67_5 = WorkT(2.4142135623730949);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_CONVOLUTION_MIN_SIZE)
+#endif
+  for (long block = 0; block < block_num; ++block)
+  {
+    // line buffers with one zero entry on each side, so the horizontal pass needs no bounds check
+    std::vector<WorkT> smooth(vcl_size_t(size2 + 2), WorkT(0)), diff(vcl_size_t(size2 + 2), WorkT(0));
+
+    for (long row = row_first + block * block_rows; row < std::min(row_first + (block + 1) * block_rows, row_last); ++row)
+    {
+      InNumericT const * up   = (row > 0)         ? data_in + p_in.offset + vcl_size_t(row - 1) * p_in.row_pitch : NULL;
+      InNumericT const * mid  =                     data_in + p_in.offset + vcl_size_t(row)     * p_in.row_pitch;
+      InNumericT const * down = (row + 1 < size1) ? data_in + p_in.offset + vcl_size_t(row + 1) * p_in.row_pitch : NULL;
+
+      for (long j = 0; j < size2; ++j)
+      {
+        vcl_size_t idx = vcl_size_t(j) * p_in.col_pitch;
+        WorkT u = up   ? WorkT(up[idx])   : WorkT(0);
+        WorkT d = down ? WorkT(down[idx]) : WorkT(0);
+        smooth[vcl_size_t(j + 1)] = u + WorkT(2) * WorkT(mid[idx]) + d;
+        diff[vcl_size_t(j + 1)]   = u - d;
+      }
+
+      for (long j = 0; j < size2; ++j)
+      {
+        WorkT vx = smooth[vcl_size_t(j + 2)] - smooth[vcl_size_t(j)];
+        WorkT vy = diff[vcl_size_t(j)] + WorkT(2) * diff[vcl_size_t(j + 1)] + diff[vcl_size_t(j + 2)];
+        if (data_out[0]) data_out[0][p_out[0].offset + vcl_size_t(row) * p_out[0].row_pitch + vcl_size_t(j) * p_out[0].col_pitch] = detail::saturate_cast<OutNumericT>(vx);
+        if (data_out[1]) data_out[1][p_out[1].offset + vcl_size_t(row) * p_out[1].row_pitch + vcl_size_t(j) * p_out[1].col_pitch] = detail::saturate_cast<OutNumericT>(vy);
+        if (data_out[2]) data_out[2][p_out[2].offset + vcl_size_t(row) * p_out[2].row_pitch + vcl_size_t(j) * p_out[2].col_pitch] = detail::saturate_cast<OutNumericT>(std::sqrt(vx * vx + vy * vy));
+        if (data_out[3])
+        {
+          WorkT angle;
+          if (orientation_bins == 4)
+          {
+            WorkT ax = std::abs(vx), ay = std::abs(vy);
+            if (ay <= tan_22_5 * ax)       angle = WorkT(0);
+            else if (ay >= tan_67_5 * ax)  angle = WorkT(2);
+            else                           angle = ((vx > 0) == (vy > 0)) ? WorkT(1) : WorkT(3);
+          }
+          else
+            angle = std::atan2(vy, vx);
+          data_out[3][p_out[3].offset + vcl_size_t(row) * p_out[3].row_pitch + vcl_size_t(j) * p_out[3].col_pitch] = detail::saturate_cast<OutNumericT>(angle);
+        }
+      }
+    }
+  }
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,1929 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_IMAGE_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_IMAGE_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/linalg/host_based/image_operations.hpp
+    @brief Implementations of per-pixel operations on multi-channel images (layout changes, channel mixing), using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/convolution_operations.hpp"
+
+// Minimum image size(size1*size2) for using OpenMP on per-pixel image operations:
+#ifndef VIENNACL_OPENMP_IMAGE_MIN_SIZE
+  #define VIENNACL_OPENMP_IMAGE_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+
+/** @brief Raw pointer plus pitches of one channel of an image, see matrix_pitches. */
+template<typename NumericT>
+struct channel_array
+{
+  NumericT       * data;
+  matrix_pitches   pitches;
+
+  NumericT * row(vcl_size_t i) const { return data + pitches.offset + i * pitches.row_pitch; }
+};
+
+template<typename NumericT>
+channel_array<NumericT> extract_channel(matrix_base<NumericT> & A)
+{
+  channel_array<NumericT> c = { extract_raw_pointer<NumericT>(A), extract_pitches(A) };
+  return c;
+}
+
+template<typename NumericT>
+channel_array<NumericT const> extract_channel(matrix_base<NumericT> const & A)
+{
+  channel_array<NumericT const> c = { extract_raw_pointer<NumericT>(A), extract_pitches(A) };
+  return c;
+}
+
+/** @brief Full scale of a pixel type: 1 for floating point pixels in [0, 1], the maximum for integer pixels (e.g. 255). */
+template<typename NumericT>
+inline double pixel_range()
+{
+  if constexpr (std::is_integral<NumericT>::value)
+    return double(std::numeric_limits<NumericT>::max());
+  else
+    return 1.0;
+}
+
+/** @brief Mirror an index at the borders without repeating the border entry, -1 -> 1 and size -> size - 2. This keeps the parity of the index, which the Bayer demosaicing relies on. */
+inline long reflect_101(long i, long size)
+{
+  if (size == 1) return 0;
+  while (i < 0 || i >= size)    // more than one reflection only for sizes below the kernel radius
+    i = (i < 0) ? -i : 2 * size - 2 - i;
+  return i;
+}
+
+/** @brief Larger (Maximum) or smaller of two pixels */
+template<bool Maximum, typename NumericT>
+inline NumericT extremum(NumericT a, NumericT b)
+{
+  return Maximum ? (a < b ? b : a) : (b < a ? b : a);
+}
+
+/** @brief Pixel value that never wins extremum<Maximum>, used for the pixels outside the image */
+template<bool Maximum, typename NumericT>
+inline NumericT extremum_identity()
+{
+  if constexpr (std::numeric_limits<NumericT>::has_infinity)
+    return Maximum ? -std::numeric_limits<NumericT>::infinity() : std::numeric_limits<NumericT>::infinity();
+  else
+    return Maximum ? std::numeric_limits<NumericT>::lowest() : std::numeric_limits<NumericT>::max();
+}
+
+/** @brief van Herk/Gil-Werman pass along the rows with an element of k columns, see morphology(). Every row is copied to the line buffers first, so src and dst may share memory. */
+template<bool Maximum, typename NumericT>
+void van_herk_rows(channel_array<NumericT const> src, channel_array<NumericT> dst, long size1, long size2, long k)
+{
+  long origin = (k - 1) / 2;
+  long n = size2 + k - 1;
+  long const block_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long block_num = (size1 + block_rows - 1) / block_rows;
+  NumericT const identity = extremum_identity<Maximum, NumericT>();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long block = 0; block < block_num; ++block)
+  {
+    std::vector<NumericT> g(static_cast<vcl_size_t>(n)), h(static_cast<vcl_size_t>(n));
+    for (long row = block * block_rows; row < std::min((block + 1) * block_rows, size1); ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      NumericT       * d = dst.row(vcl_size_t(row));
+      for (long i = 0; i < n; ++i)
+      {
+        long col = i - origin;
+        g[vcl_size_t(i)] = h[vcl_size_t(i)] = (col >= 0 && col < size2) ? s[vcl_size_t(col) * src.pitches.col_pitch] : identity;
+      }
+      for (long b = 0; b < n; b += k)
+      {
+        long e = std::min(b + k, n);
+        for (long i = b + 1; i < e; ++i)
+          g[vcl_size_t(i)] = extremum<Maximum>(g[vcl_size_t(i - 1)], g[vcl_size_t(i)]);
+        for (long i = e - 2; i >= b; --i)
+          h[vcl_size_t(i)] = extremum<Maximum>(h[vcl_size_t(i + 1)], h[vcl_size_t(i)]);
+      }
+      for (long col = 0; col < size2; ++col)
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = extremum<Maximum>(h[vcl_size_t(col)], g[vcl_size_t(col + k - 1)]);
+    }
+  }
+}
+
+/** @brief van Herk/Gil-Werman pass along the columns with an element of k rows, see morphology(). A block of columns is copied to the buffers first, so src and dst may share memory. */
+template<bool Maximum, typename NumericT>
+void van_herk_columns(channel_array<NumericT const> src, channel_array<NumericT> dst, long size1, long size2, long k)
+{
+  long origin = (k - 1) / 2;
+  long n = size1 + k - 1;
+  long const block_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long block_num = (size2 + block_cols - 1) / block_cols;
+  NumericT const identity = extremum_identity<Maximum, NumericT>();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long block = 0; block < block_num; ++block)
+  {
+    long col_begin = block * block_cols;
+    long len = std::min(col_begin + block_cols, size2) - col_begin;
+    // n x len buffers, one line per padded row
+    std::vector<NumericT> g(static_cast<vcl_size_t>(n * len)), h(static_cast<vcl_size_t>(n * len));
+    for (long i = 0; i < n; ++i)
+    {
+      long row = i - origin;
+      NumericT * gi = &g[vcl_size_t(i * len)];
+      if (row >= 0 && row < size1)
+      {
+        NumericT const * s = src.row(vcl_size_t(row)) + vcl_size_t(col_begin) * src.pitches.col_pitch;
+        for (long j = 0; j < len; ++j)
+          gi[j] = s[vcl_size_t(j) * src.pitches.col_pitch];
+      }
+      else
+        std::fill(gi, gi + len, identity);
+    }
+    std::copy(g.begin(), g.end(), h.begin());
+    for (long b = 0; b < n; b += k)
+    {
+      long e = std::min(b + k, n);
+      for (long i = b + 1; i < e; ++i)
+      {
+        NumericT const * g0 = &g[vcl_size_t((i - 1) * len)];
+        NumericT       * g1 = &g[vcl_size_t(i * len)];
+        for (long j = 0; j < len; ++j)
+          g1[j] = extremum<Maximum>(g0[j], g1[j]);
+      }
+      for (long i = e - 2; i >= b; --i)
+      {
+        NumericT const * h0 = &h[vcl_size_t((i + 1) * len)];
+        NumericT       * h1 = &h[vcl_size_t(i * len)];
+        for (long j = 0; j < len; ++j)
+          h1[j] = extremum<Maximum>(h0[j], h1[j]);
+      }
+    }
+    for (long row = 0; row < size1; ++row)
+    {
+      NumericT const * hr = &h[vcl_size_t(row * len)];
+      NumericT const * gr = &g[vcl_size_t((row + k - 1) * len)];
+      NumericT       * d  = dst.row(vcl_size_t(row)) + vcl_size_t(col_begin) * dst.pitches.col_pitch;
+      for (long j = 0; j < len; ++j)
+        d[vcl_size_t(j) * dst.pitches.col_pitch] = extremum<Maximum>(hr[j], gr[j]);
+    }
+  }
+}
+
+/** @brief Constant-time median of 8-bit pixels (Perreault-Hebert), see median(). Every thread owns a strip of columns and walks it top to bottom,
+* keeping a 256-bin histogram per column of the rows [y - radius, y + radius] and a kernel histogram that slides along the row by adding one column
+* histogram and removing another. Both levels carry a 16-bin coarse histogram so that the median search visits at most 32 bins. */
+inline void median_histogram_u8(channel_array<unsigned char const> src, channel_array<unsigned char> dst, long size1, long size2, long radius)
+{
+  long const strip = std::max<long>(VIENNACL_CONVOLUTION_TILE_COLS, 8 * (2 * radius + 1));
+  long block_num = (size2 + strip - 1) / strip;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long block = 0; block < block_num; ++block)
+  {
+    long col_begin = block * strip;
+    long col_end   = std::min(col_begin + strip, size2);
+    long hist_begin = std::max(col_begin - radius, 0L);
+    long hist_end   = std::min(col_end + radius, size2);
+    std::vector<unsigned short> column_fine(vcl_size_t((hist_end - hist_begin) * 256), 0), column_coarse(vcl_size_t((hist_end - hist_begin) * 16), 0);
+    unsigned short fine[256], coarse[16];
+
+    for (long row = -radius - 1; row < size1; ++row)
+    {
+      // column histograms: rows [row - radius, row + radius]
+      for (long r_sign = -1; r_sign <= 1; r_sign += 2)
+      {
+        long r = (r_sign < 0) ? row - radius - 1 : row + radius;
+        if (r < 0 || r >= size1)
+          continue;
+        unsigned char const * s = src.row(vcl_size_t(r));
+        for (long col = hist_begin; col < hist_end; ++col)
+        {
+          unsigned char v = s[vcl_size_t(col) * src.pitches.col_pitch];
+          column_fine[vcl_size_t((col - hist_begin) * 256 + v)]       += (unsigned short)r_sign;
+          column_coarse[vcl_size_t((col - hist_begin) * 16 + (v >> 4))] += (unsigned short)r_sign;
+        }
+      }
+      if (row < 0)
+        continue;
+      long rows_in = std::min(row + radius, size1 - 1) - std::max(row - radius, 0L) + 1;
+
+      // kernel histogram: columns [col - radius, col + radius]
+      std::fill(fine, fine + 256, (unsigned short)0);
+      std::fill(coarse, coarse + 16, (unsigned short)0);
+      unsigned char * d = dst.row(vcl_size_t(row));
+      for (long col = col_begin - 2 * radius; col < col_end; ++col)
+      {
+        for (long c_sign = -1; c_sign <= 1; c_sign += 2)
+        {
+          long c = (c_sign < 0) ? col - radius - 1 : col + radius;
+          if (c < hist_begin || c >= hist_end || (c_sign < 0 && col <= col_begin))
+            continue;
+          unsigned short const * cf = &column_fine[vcl_size_t((c - hist_begin) * 256)];
+          unsigned short const * cc = &column_coarse[vcl_size_t((c - hist_begin) * 16)];
+          if (c_sign > 0)
+          {
+            for (long i = 0; i < 256; ++i) fine[i]   = (unsigned short)(fine[i] + cf[i]);
+            for (long i = 0; i < 16; ++i)  coarse[i] = (unsigned short)(coarse[i] + cc[i]);
+          }
+          else
+          {
+            for (long i = 0; i < 256; ++i) fine[i]   = (unsigned short)(fine[i] - cf[i]);
+            for (long i = 0; i < 16; ++i)  coarse[i] = (unsigned short)(coarse[i] - cc[i]);
+          }
+        }
+        if (col < col_begin)
+          continue;
+
+        long cols_in = std::min(col + radius, size2 - 1) - std::max(col - radius, 0L) + 1;
+        long rank = (rows_in * cols_in - 1) / 2;     // lower median of the pixels inside the image
+        long count = 0, bin = 0;
+        while (count + coarse[bin] <= rank)
+          count += coarse[bin++];
+        bin *= 16;
+        while (count + fine[bin] <= rank)
+          count += fine[bin++];
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = (unsigned char)bin;
+      }
+    }
+  }
+}
+
+/** @brief Blur every line of a bilateral grid along one axis by [1 4 6 4 1] / 16, the entries beyond the grid being zero. Line l starts at
+* (l / inner_num) * outer_stride + (l % inner_num) * inner_stride and has length entries of two floats (sum, weight) 'stride' floats apart. */
+inline void blur_grid_axis(std::vector<float> & grid, long line_num, long inner_num, long outer_stride, long inner_stride, long length, long stride)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((line_num*length) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long line = 0; line < line_num; ++line)
+  {
+    float * base = &grid[vcl_size_t((line / inner_num) * outer_stride + (line % inner_num) * inner_stride)];
+    std::vector<float> t(vcl_size_t(2 * (length + 4)), 0.0f);   // copy of the line with two zero entries on each side
+    for (long i = 0; i < length; ++i)
+    {
+      t[vcl_size_t(2 * (i + 2))]     = base[i * stride];
+      t[vcl_size_t(2 * (i + 2) + 1)] = base[i * stride + 1];
+    }
+    for (long i = 0; i < length; ++i)
+    for (long k = 0; k < 2; ++k)
+    {
+      float const * c = &t[vcl_size_t(2 * (i + 2) + k)];
+      base[i * stride + k] = (c[-4] + 4.0f * c[-2] + 6.0f * c[0] + 4.0f * c[2] + c[4]) * (1.0f / 16.0f);
+    }
+  }
+}
+
+/** @brief Depth-first growth of strong pixels (label 2) into 8-connected weak pixels (label 1) inside one tile, the stack holding row * size2 + col of the strong pixels still to visit. The stack is empty on return. */
+inline void grow_in_tile(channel_array<unsigned char> lab, std::vector<long> & stack,
+                         long row_begin, long row_end, long col_begin, long col_end, long size2)
+{
+  while (!stack.empty())
+  {
+    long index = stack.back();
+    stack.pop_back();
+    long row = index / size2, col = index % size2;
+    for (long r = std::max(row - 1, row_begin); r <= std::min(row + 1, row_end - 1); ++r)
+    {
+      unsigned char * l = lab.row(vcl_size_t(r));
+      for (long c = std::max(col - 1, col_begin); c <= std::min(col + 1, col_end - 1); ++c)
+        if (l[vcl_size_t(c) * lab.pitches.col_pitch] == 1)
+        {
+          l[vcl_size_t(c) * lab.pitches.col_pitch] = 2;
+          stack.push_back(r * size2 + c);
+        }
+    }
+  }
+}
+
+/** @brief Root of a pixel in a union-find forest whose roots are the smallest index of their set, halving the path on the way */
+inline long find_root(std::vector<long> & parent, long i)
+{
+  while (parent[vcl_size_t(i)] != i)
+  {
+    parent[vcl_size_t(i)] = parent[vcl_size_t(parent[vcl_size_t(i)])];
+    i = parent[vcl_size_t(i)];
+  }
+  return i;
+}
+
+/** @brief Merge the sets of two pixels, the smaller root becoming the root of both */
+inline void unite(std::vector<long> & parent, long a, long b)
+{
+  a = find_root(parent, a);
+  b = find_root(parent, b);
+  if (a < b)      parent[vcl_size_t(b)] = a;
+  else if (b < a) parent[vcl_size_t(a)] = b;
+}
+
+/** @brief Histogram bin of a pixel for 'bins' bins over [lo, hi), scale = bins / (hi - lo), clamped to the first and last bins */
+template<typename NumericT>
+inline long histogram_bin(NumericT value, double lo, double scale, long bins)
+{
+  long bin = long(std::floor((double(value) - lo) * scale));
+  return std::min(std::max(bin, 0L), bins - 1);
+}
+
+/** @brief Look up a cumulative table of bins + 1 entries at the bin edges, interpolating linearly inside the bin. An integer pixel v stands for the interval [v, v + 1), so with one bin per value it reads the inclusive cumulative count of its bin. */
+template<typename NumericT>
+inline double cumulative_lookup(double const * edges, NumericT value, double lo, double scale, long bins)
+{
+  long bin = histogram_bin(value, lo, scale, bins);
+  double f = (double(value) + (std::is_integral<NumericT>::value ? 1.0 : 0.0) - lo) * scale - double(bin);
+  f = std::min(std::max(f, 0.0), 1.0);
+  return edges[bin] + f * (edges[bin + 1] - edges[bin]);
+}
+
+/** @brief Cumulative tables of several histograms (e.g. one per tile) stored one after the other with bins + 1 edges each. For 8-bit pixels the lookup of
+*  every possible value is tabulated once, so mapping a pixel is a single load instead of a bin computation. */
+template<typename NumericT>
+class cumulative_tables
+{
+  static const bool tabulated = std::is_integral<NumericT>::value && (sizeof(NumericT) == 1);
+  static const long values = 256;
+
+public:
+  cumulative_tables(std::vector<double> const & edges, long bins, double lo, double hi)
+    : edges_(edges), bins_(bins), lo_(lo), scale_(double(bins) / (hi - lo))
+  {
+    if (tabulated)
+    {
+      long count = static_cast<long>(edges.size()) / (bins + 1);
+      values_.resize(vcl_size_t(count * values));
+      for (long k = 0; k < count; ++k)
+        for (long v = 0; v < values; ++v)
+          values_[vcl_size_t(k * values + v)] = cumulative_lookup(&edges_[vcl_size_t(k * (bins + 1))], NumericT(v + long(std::numeric_limits<NumericT>::min())), lo_, scale_, bins_);
+    }
+  }
+
+  /** @brief Cumulative distribution of table k at value */
+  double operator()(long k, NumericT value) const
+  {
+    if (tabulated)
+      return values_[vcl_size_t(k * values + long(value) - long(std::numeric_limits<NumericT>::min()))];
+    return cumulative_lookup(&edges_[vcl_size_t(k * (bins_ + 1))], value, lo_, scale_, bins_);
+  }
+
+private:
+  std::vector<double> const & edges_;
+  long bins_;
+  double lo_, scale_;
+  std::vector<double> values_;
+};
+
+/** @brief Read a sample of type SampleT from possibly unaligned memory, reversing its bytes if it is stored in the other byte order */
+template<typename SampleT>
+inline SampleT load_sample(unsigned char const * p, bool swap_bytes)
+{
+  unsigned char bytes[sizeof(SampleT)];
+  for (vcl_size_t k = 0; k < sizeof(SampleT); ++k)
+    bytes[k] = swap_bytes ? p[sizeof(SampleT) - 1 - k] : p[k];
+  SampleT value;
+  std::memcpy(&value, bytes, sizeof(SampleT));
+  return value;
+}
+
+/** @brief Write a sample of type SampleT to possibly unaligned memory, reversing its bytes if it is to be stored in the other byte order */
+template<typename SampleT>
+inline void store_sample(unsigned char * p, SampleT value, bool swap_bytes)
+{
+  unsigned char bytes[sizeof(SampleT)];
+  std::memcpy(bytes, &value, sizeof(SampleT));
+  for (vcl_size_t k = 0; k < sizeof(SampleT); ++k)
+    p[k] = swap_bytes ? bytes[sizeof(SampleT) - 1 - k] : bytes[k];
+}
+
+/** @brief One row of one channel for import_samples(), the byte order and the scaling being fixed at compile time so the loop stays simple */
+template<bool SwapBytes, bool Scaled, typename SampleT, typename NumericT>
+inline void import_row(unsigned char const * src, long column_stride, double scale, NumericT * dst, vcl_size_t col_pitch, long size2)
+{
+  for (long col = 0; col < size2; ++col)
+  {
+    SampleT value = load_sample<SampleT>(src + col * column_stride, SwapBytes);
+    dst[vcl_size_t(col) * col_pitch] = Scaled ? saturate_cast<NumericT>(double(value) * scale) : saturate_cast<NumericT>(value);
+  }
+}
+
+/** @brief One row of one channel for export_samples(), see import_row() */
+template<bool SwapBytes, bool Scaled, typename SampleT, typename NumericT>
+inline void export_row(NumericT const * src, vcl_size_t col_pitch, double scale, unsigned char * dst, long column_stride, long size2)
+{
+  for (long col = 0; col < size2; ++col)
+  {
+    NumericT value = src[vcl_size_t(col) * col_pitch];
+    store_sample(dst + col * column_stride, Scaled ? saturate_cast<SampleT>(double(value) * scale) : saturate_cast<SampleT>(value), SwapBytes);
+  }
+}
+
+} //namespace detail
+
+//
+// Introductory note: By convention, all dimensions are already checked in the dispatcher frontend. No need to double-check again in here!
+//
+
+/** @brief Copies a set of channels to another set of channels of the same size in a single pass over the pixels, converting the numeric type on the fly (rounded and saturated for integer destinations).
+*
+* Used to change between planar and interleaved layouts: every pixel of every channel is read once and written once, rows are distributed over threads.
+*
+* @param in   Input channels
+* @param out  Output channels, as many as input channels
+*/
+template<typename DestNumericT, typename SrcNumericT>
+void copy_channels(std::vector<matrix_base<SrcNumericT> const *> const & in,
+                   std::vector<matrix_base<DestNumericT> *> const & out)
+{
+  std::vector<detail::channel_array<SrcNumericT const> > src;
+  std::vector<detail::channel_array<DestNumericT> >      dst;
+  for (vcl_size_t c = 0; c < in.size(); ++c)
+  {
+    src.push_back(detail::extract_channel(*in[c]));
+    dst.push_back(detail::extract_channel(*out[c]));
+  }
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*in[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*in[0]));
+  vcl_size_t color_num = in.size();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+    for (long col = 0; col < size2; ++col)
+      for (vcl_size_t c = 0; c < color_num; ++c)
+        dst[c].row(vcl_size_t(row))[vcl_size_t(col) * dst[c].pitches.col_pitch]
+          = detail::saturate_cast<DestNumericT>(src[c].row(vcl_size_t(row))[vcl_size_t(col) * src[c].pitches.col_pitch]);
+}
+
+/** @brief Reads channels from a host buffer of samples with arbitrary strides, out_c(i, j) = scale * sample(src + c * channel_stride + i * row_stride + j * column_stride),
+* converting the sample type to the pixel type on the fly (rounded and saturated for integer pixels), e.g. from an interleaved (HWC) or planar (CHW) frame.
+*
+* All channels of a row are read while the row is in cache, so interleaved samples are fetched from memory once. Samples need not be aligned, and the strides may be negative
+* (e.g. for images stored bottom-up). Rows of contiguous samples of the pixel type are copied with one memcpy per channel. Rows are distributed over threads.
+*
+* @param src             Address of the sample of channel 0 at pixel (0, 0)
+* @param channel_stride  Distance between two channels in bytes
+* @param row_stride      Distance between two rows in bytes
+* @param column_stride   Distance between two pixels of a row in bytes
+* @param scale           Factor applied to every sample, 1 to convert the value only
+* @param swap_bytes      Whether the samples are stored in the other byte order than the host
+* @param out             Output channels of the same size
+*/
+template<typename SampleT, typename NumericT>
+void import_samples(unsigned char const * src,
+                    long channel_stride,
+                    long row_stride,
+                    long column_stride,
+                    double scale,
+                    bool swap_bytes,
+                    std::vector<matrix_base<NumericT> *> const & out)
+{
+  std::vector<detail::channel_array<NumericT> > dst;
+  bool row_copy = std::is_same<SampleT, NumericT>::value && (scale == 1.0) && (!swap_bytes || sizeof(SampleT) == 1) && (column_stride == long(sizeof(SampleT)));
+  for (vcl_size_t c = 0; c < out.size(); ++c)
+  {
+    dst.push_back(detail::extract_channel(*out[c]));
+    row_copy = row_copy && (dst[c].pitches.col_pitch == 1);
+  }
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*out[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*out[0]));
+  long color_num = static_cast<long>(out.size());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    unsigned char const * s = src + row * row_stride;
+    if (row_copy)
+    {
+      for (long c = 0; c < color_num; ++c)
+        std::memcpy(dst[vcl_size_t(c)].row(vcl_size_t(row)), s + c * channel_stride, vcl_size_t(size2) * sizeof(NumericT));
+      continue;
+    }
+    for (long c = 0; c < color_num; ++c)
+    {
+      NumericT * d = dst[vcl_size_t(c)].row(vcl_size_t(row));
+      vcl_size_t col_pitch = dst[vcl_size_t(c)].pitches.col_pitch;
+      if (swap_bytes)
+        detail::import_row<true, true, SampleT>(s + c * channel_stride, column_stride, scale, d, col_pitch, size2);
+      else if (scale != 1.0)
+        detail::import_row<false, true, SampleT>(s + c * channel_stride, column_stride, scale, d, col_pitch, size2);
+      else
+        detail::import_row<false, false, SampleT>(s + c * channel_stride, column_stride, scale, d, col_pitch, size2);
+    }
+  }
+}
+
+/** @brief Writes channels to a host buffer of samples with arbitrary strides, sample(dst + c * channel_stride + i * row_stride + j * column_stride) = scale * in_c(i, j),
+* the inverse of import_samples(). Rows are distributed over threads.
+*
+* @param in              Input channels of the same size
+* @param dst             Address of the sample of channel 0 at pixel (0, 0)
+* @param channel_stride  Distance between two channels in bytes
+* @param row_stride      Distance between two rows in bytes
+* @param column_stride   Distance between two pixels of a row in bytes
+* @param scale           Factor applied to every pixel, 1 to convert the value only
+* @param swap_bytes      Whether the samples are to be stored in the other byte order than the host
+*/
+template<typename SampleT, typename NumericT>
+void export_samples(std::vector<matrix_base<NumericT> const *> const & in,
+                    unsigned char * dst,
+                    long channel_stride,
+                    long row_stride,
+                    long column_stride,
+                    double scale,
+                    bool swap_bytes)
+{
+  std::vector<detail::channel_array<NumericT const> > src;
+  bool row_copy = std::is_same<SampleT, NumericT>::value && (scale == 1.0) && (!swap_bytes || sizeof(SampleT) == 1) && (column_stride == long(sizeof(SampleT)));
+  for (vcl_size_t c = 0; c < in.size(); ++c)
+  {
+    src.push_back(detail::extract_channel(*in[c]));
+    row_copy = row_copy && (src[c].pitches.col_pitch == 1);
+  }
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*in[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*in[0]));
+  long color_num = static_cast<long>(in.size());
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    unsigned char * d = dst + row * row_stride;
+    if (row_copy)
+    {
+      for (long c = 0; c < color_num; ++c)
+        std::memcpy(d + c * channel_stride, src[vcl_size_t(c)].row(vcl_size_t(row)), vcl_size_t(size2) * sizeof(NumericT));
+      continue;
+    }
+    for (long c = 0; c < color_num; ++c)
+    {
+      NumericT const * s = src[vcl_size_t(c)].row(vcl_size_t(row));
+      vcl_size_t col_pitch = src[vcl_size_t(c)].pitches.col_pitch;
+      if (swap_bytes)
+        detail::export_row<true, true, SampleT>(s, col_pitch, scale, d + c * channel_stride, column_stride, size2);
+      else if (scale != 1.0)
+        detail::export_row<false, true, SampleT>(s, col_pitch, scale, d + c * channel_stride, column_stride, size2);
+      else
+        detail::export_row<false, false, SampleT>(s, col_pitch, scale, d + c * channel_stride, column_stride, size2);
+    }
+  }
+}
+
+/** @brief Affine color transform, out_k(i, j) = sum_c coefficients[k * in.size() + c] * in_c(i, j) + offsets[k], in a single pass over the pixels (e.g. RGB <-> YCbCr, Gray -> RGB).
+*
+* Every row is processed in blocks of VIENNACL_CONVOLUTION_TILE_COLS columns: the input block is read from memory once, the output channels are accumulated
+* in a local buffer by contiguous loops the compiler can vectorize, and every output pixel is written once, rounded and saturated for integer pixels. Rows are distributed over threads.
+*
+* @param in            Input channels
+* @param coefficients  Row-major out.size() x in.size() coefficient matrix
+* @param offsets       One offset per output channel
+* @param out           Output channels of the same size, must not share memory with any input channel
+*/
+template<typename NumericT>
+void linear_color_transform(std::vector<matrix_base<NumericT> const *> const & in,
+                            std::vector<double> const & coefficients,
+                            std::vector<double> const & offsets,
+                            std::vector<matrix_base<NumericT> *> const & out)
+{
+  typedef typename std::conditional<std::is_same<NumericT, double>::value, double, float>::type WorkT;
+
+  std::vector<detail::channel_array<NumericT const> > src;
+  std::vector<detail::channel_array<NumericT> >       dst;
+  for (vcl_size_t c = 0; c < in.size(); ++c)
+    src.push_back(detail::extract_channel(*in[c]));
+  for (vcl_size_t k = 0; k < out.size(); ++k)
+    dst.push_back(detail::extract_channel(*out[k]));
+  std::vector<WorkT> coef(coefficients.begin(), coefficients.end());
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*out[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*out[0]));
+  long const block = VIENNACL_CONVOLUTION_TILE_COLS;
+  vcl_size_t in_num = in.size(), out_num = out.size();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    WorkT acc[VIENNACL_CONVOLUTION_TILE_COLS];
+    for (long col_begin = 0; col_begin < size2; col_begin += block)
+    {
+      long len = std::min(block, size2 - col_begin);
+      for (vcl_size_t k = 0; k < out_num; ++k)
+      {
+        std::fill(acc, acc + len, WorkT(offsets[k]));
+        for (vcl_size_t c = 0; c < in_num; ++c)
+        {
+          WorkT            w = coef[k * in_num + c];
+          NumericT const * s = src[c].row(vcl_size_t(row)) + vcl_size_t(col_begin) * src[c].pitches.col_pitch;
+          if (src[c].pitches.col_pitch == 1)
+            for (long j = 0; j < len; ++j)
+              acc[j] += w * WorkT(s[j]);
+          else
+            for (long j = 0; j < len; ++j)
+              acc[j] += w * WorkT(s[vcl_size_t(j) * src[c].pitches.col_pitch]);
+        }
+        NumericT * d = dst[k].row(vcl_size_t(row)) + vcl_size_t(col_begin) * dst[k].pitches.col_pitch;
+        for (long j = 0; j < len; ++j)
+          d[vcl_size_t(j) * dst[k].pitches.col_pitch] = detail::saturate_cast<NumericT>(acc[j]);
+      }
+    }
+  }
+}
+
+/** @brief RGB -> HSV in a single pass over the pixels. H, S and V all span the full pixel range (see detail::pixel_range), H = 0 and H = full scale both being red.
+*
+* @param in   R, G and B channels
+* @param out  H, S and V channels of the same size, must not share memory with the input
+*/
+template<typename NumericT>
+void rgb_to_hsv(std::vector<matrix_base<NumericT> const *> const & in,
+                std::vector<matrix_base<NumericT> *> const & out)
+{
+  detail::channel_array<NumericT const> src[3] = { detail::extract_channel(*in[0]), detail::extract_channel(*in[1]), detail::extract_channel(*in[2]) };
+  detail::channel_array<NumericT>       dst[3] = { detail::extract_channel(*out[0]), detail::extract_channel(*out[1]), detail::extract_channel(*out[2]) };
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*out[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*out[0]));
+  double scale = detail::pixel_range<NumericT>();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * r = src[0].row(vcl_size_t(row));
+    NumericT const * g = src[1].row(vcl_size_t(row));
+    NumericT const * b = src[2].row(vcl_size_t(row));
+    NumericT * h = dst[0].row(vcl_size_t(row));
+    NumericT * s = dst[1].row(vcl_size_t(row));
+    NumericT * v = dst[2].row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+    {
+      double R = double(r[vcl_size_t(col) * src[0].pitches.col_pitch]);
+      double G = double(g[vcl_size_t(col) * src[1].pitches.col_pitch]);
+      double B = double(b[vcl_size_t(col) * src[2].pitches.col_pitch]);
+      double max_value = std::max(R, std::max(G, B));
+      double delta     = max_value - std::min(R, std::min(G, B));
+      double hue = 0;
+      if (delta > 0)
+      {
+        if (max_value == R)      hue = (G - B) / delta;
+        else if (max_value == G) hue = (B - R) / delta + 2.0;
+        else                     hue = (R - G) / delta + 4.0;
+        hue /= 6.0;
+        if (hue < 0) hue += 1.0;
+      }
+      h[vcl_size_t(col) * dst[0].pitches.col_pitch] = detail::saturate_cast<NumericT>(hue * scale);
+      s[vcl_size_t(col) * dst[1].pitches.col_pitch] = detail::saturate_cast<NumericT>(max_value > 0 ? delta / max_value * scale : 0.0);
+      v[vcl_size_t(col) * dst[2].pitches.col_pitch] = detail::saturate_cast<NumericT>(max_value);
+    }
+  }
+}
+
+/** @brief HSV -> RGB in a single pass over the pixels, the inverse of rgb_to_hsv().
+*
+* @param in   H, S and V channels
+* @param out  R, G and B channels of the same size, must not share memory with the input
+*/
+template<typename NumericT>
+void hsv_to_rgb(std::vector<matrix_base<NumericT> const *> const & in,
+                std::vector<matrix_base<NumericT> *> const & out)
+{
+  detail::channel_array<NumericT const> src[3] = { detail::extract_channel(*in[0]), detail::extract_channel(*in[1]), detail::extract_channel(*in[2]) };
+  detail::channel_array<NumericT>       dst[3] = { detail::extract_channel(*out[0]), detail::extract_channel(*out[1]), detail::extract_channel(*out[2]) };
+
+  long size1 = static_cast<long>(viennacl::traits::size1(*out[0]));
+  long size2 = static_cast<long>(viennacl::traits::size2(*out[0]));
+  double scale = detail::pixel_range<NumericT>();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * h = src[0].row(vcl_size_t(row));
+    NumericT const * s = src[1].row(vcl_size_t(row));
+    NumericT const * v = src[2].row(vcl_size_t(row));
+    NumericT * r = dst[0].row(vcl_size_t(row));
+    NumericT * g = dst[1].row(vcl_size_t(row));
+    NumericT * b = dst[2].row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+    {
+      double H = double(h[vcl_size_t(col) * src[0].pitches.col_pitch]) / scale * 6.0;
+      double S = double(s[vcl_size_t(col) * src[1].pitches.col_pitch]) / scale;
+      double V = double(v[vcl_size_t(col) * src[2].pitches.col_pitch]);
+      long   sector = static_cast<long>(std::floor(H));
+      double f = H - double(sector);
+      double p = V * (1.0 - S), q = V * (1.0 - S * f), t = V * (1.0 - S * (1.0 - f));
+      double R, G, B;
+      switch (((sector % 6) + 6) % 6)
+      {
+        case 0:  R = V; G = t; B = p; break;
+        case 1:  R = q; G = V; B = p; break;
+        case 2:  R = p; G = V; B = t; break;
+        case 3:  R = p; G = q; B = V; break;
+        case 4:  R = t; G = p; B = V; break;
+        default: R = V; G = p; B = q; break;
+      }
+      r[vcl_size_t(col) * dst[0].pitches.col_pitch] = detail::saturate_cast<NumericT>(R);
+      g[vcl_size_t(col) * dst[1].pitches.col_pitch] = detail::saturate_cast<NumericT>(G);
+      b[vcl_size_t(col) * dst[2].pitches.col_pitch] = detail::saturate_cast<NumericT>(B);
+    }
+  }
+}
+
+/** @brief Bilinear demosaicing of a Bayer mosaic into R, G and B channels in a single pass over the pixels.
+*
+* The color of the pixel (i, j) of the mosaic is pattern[2 * (i % 2) + (j % 2)], with 0 = R, 1 = G and 2 = B (e.g. {0, 1, 1, 2} for RGGB).
+* The measured color is copied, a missing G is the mean of the 4 direct neighbours, a missing R or B the mean of the 2 neighbours in the row or column carrying it, or of the 4 diagonal neighbours.
+* Borders are mirrored without repeating the border pixel, which keeps the mosaic pattern intact.
+*
+* @param in       Mosaic
+* @param pattern  Colors of the 2 x 2 mosaic cell
+* @param out      R, G and B channels of the same size, must not share memory with the input
+*/
+template<typename NumericT>
+void demosaic_bilinear(matrix_base<NumericT> const & in,
+                       unsigned int const (&pattern)[4],
+                       std::vector<matrix_base<NumericT> *> const & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst[3] = { detail::extract_channel(*out[0]), detail::extract_channel(*out[1]), detail::extract_channel(*out[2]) };
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  vcl_size_t cp = src.pitches.col_pitch;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * up   = src.row(vcl_size_t(detail::reflect_101(row - 1, size1)));
+    NumericT const * mid  = src.row(vcl_size_t(row));
+    NumericT const * down = src.row(vcl_size_t(detail::reflect_101(row + 1, size1)));
+    unsigned int const * row_pattern  = pattern + 2 * (row % 2);
+    unsigned int const * next_pattern = pattern + 2 * ((row + 1) % 2);
+    for (long col = 0; col < size2; ++col)
+    {
+      vcl_size_t left  = vcl_size_t(detail::reflect_101(col - 1, size2)) * cp;
+      vcl_size_t here  = vcl_size_t(col) * cp;
+      vcl_size_t right = vcl_size_t(detail::reflect_101(col + 1, size2)) * cp;
+      unsigned int site      = row_pattern[col % 2];
+      unsigned int row_other = row_pattern[(col + 1) % 2];    // color of the left and right neighbours
+      unsigned int col_other = next_pattern[col % 2];         // color of the upper and lower neighbours
+
+      double cross      = 0.25 * (double(up[here]) + double(down[here]) + double(mid[left]) + double(mid[right]));
+      double horizontal = 0.5  * (double(mid[left]) + double(mid[right]));
+      double vertical   = 0.5  * (double(up[here]) + double(down[here]));
+      double diagonal   = 0.25 * (double(up[left]) + double(up[right]) + double(down[left]) + double(down[right]));
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        double value;
+        if (c == site)                                value = double(mid[here]);
+        else if (c == row_other && c == col_other)    value = cross;
+        else if (c == row_other)                      value = horizontal;
+        else if (c == col_other)                      value = vertical;
+        else                                          value = diagonal;
+        dst[c].row(vcl_size_t(row))[vcl_size_t(col) * dst[c].pitches.col_pitch] = detail::saturate_cast<NumericT>(value);
+      }
+    }
+  }
+}
+
+/** @brief One level down an image pyramid: blur by the 5 x 5 binomial kernel [1 4 6 4 1]^T [1 4 6 4 1] / 256 and keep every second row and column, out(i, j) = blurred(2i, 2j).
+*
+* Only the retained pixels are computed: for every output row the 5 contributing input rows are summed vertically into a local buffer of one column block,
+* then the horizontal taps are applied at the even columns only. Borders are mirrored as in detail::reflect_101(). Integer pixels accumulate exactly in long and are rounded once.
+*
+* @param in   Input matrix
+* @param out  Output matrix of size ((size1(in) + 1) / 2) x ((size2(in) + 1) / 2), must not share memory with in
+*/
+template<typename NumericT>
+void pyramid_down(matrix_base<NumericT> const & in,
+                  matrix_base<NumericT> & out)
+{
+  typedef typename std::conditional<std::is_integral<NumericT>::value, long, NumericT>::type WorkT;
+
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long in_size1  = static_cast<long>(viennacl::traits::size1(in));
+  long in_size2  = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  long const block = VIENNACL_CONVOLUTION_TILE_COLS / 2;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < out_size1; ++row)
+  {
+    WorkT buffer[VIENNACL_CONVOLUTION_TILE_COLS + 4];
+    NumericT const * r[5];
+    for (long k = 0; k < 5; ++k)
+      r[k] = src.row(vcl_size_t(detail::reflect_101(2 * row + k - 2, in_size1)));
+    NumericT * d = dst.row(vcl_size_t(row));
+
+    for (long col_begin = 0; col_begin < out_size2; col_begin += block)
+    {
+      long col_end  = std::min(col_begin + block, out_size2);
+      long in_begin = 2 * col_begin - 2;
+      long in_len   = 2 * (col_end - col_begin) + 3;
+      for (long t = 0; t < in_len; ++t)
+      {
+        vcl_size_t x = vcl_size_t(detail::reflect_101(in_begin + t, in_size2)) * src.pitches.col_pitch;
+        buffer[t] = WorkT(r[0][x]) + WorkT(r[4][x]) + WorkT(4) * (WorkT(r[1][x]) + WorkT(r[3][x])) + WorkT(6) * WorkT(r[2][x]);
+      }
+      for (long col = col_begin; col < col_end; ++col)
+      {
+        WorkT const * b = buffer + 2 * (col - col_begin);
+        WorkT sum = b[0] + b[4] + WorkT(4) * (b[1] + b[3]) + WorkT(6) * b[2];
+        if constexpr (std::is_integral<NumericT>::value)
+          d[vcl_size_t(col) * dst.pitches.col_pitch] = detail::saturate_cast<NumericT>((sum + 128) >> 8);
+        else
+          d[vcl_size_t(col) * dst.pitches.col_pitch] = sum * NumericT(1.0 / 256.0);
+      }
+    }
+  }
+}
+
+/** @brief One level up an image pyramid: insert zeros between the pixels and blur by 4 * [1 4 6 4 1]^T [1 4 6 4 1] / 256, i.e. the even output rows and columns take [1 6 1] / 8 and the odd ones [4 4] / 8 of their input neighbours.
+*
+* The result is written (sign = 0), subtracted from out (sign = -1, Laplacian level) or added to out (sign = 1, reconstruction) in the same pass, saturated for integer pixels.
+* The border beyond the last input pixel is replicated, the one before the first mirrored, as for the zero inserted image mirrored by detail::reflect_101().
+*
+* @param in    Input matrix
+* @param out   Output matrix, size1(out) is 2 * size1(in) or 2 * size1(in) - 1, same for size2. Must not share memory with in.
+* @param sign  0 to overwrite out, -1 to subtract from it, 1 to add to it
+*/
+template<typename NumericT>
+void pyramid_up(matrix_base<NumericT> const & in,
+                matrix_base<NumericT> & out,
+                int sign = 0)
+{
+  typedef typename std::conditional<std::is_integral<NumericT>::value, long, NumericT>::type WorkT;
+
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long in_size1  = static_cast<long>(viennacl::traits::size1(in));
+  long in_size2  = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  long const block = VIENNACL_CONVOLUTION_TILE_COLS;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < out_size1; ++row)
+  {
+    WorkT buffer[VIENNACL_CONVOLUTION_TILE_COLS / 2 + 4];
+    long i = row / 2;
+    NumericT const * r_lo  = src.row(vcl_size_t(i > 0 ? i - 1 : std::min(1L, in_size1 - 1)));
+    NumericT const * r_mid = src.row(vcl_size_t(i));
+    NumericT const * r_hi  = src.row(vcl_size_t(std::min(i + 1, in_size1 - 1)));
+    NumericT * d = dst.row(vcl_size_t(row));
+
+    for (long col_begin = 0; col_begin < out_size2; col_begin += block)
+    {
+      long col_end  = std::min(col_begin + block, out_size2);
+      long in_begin = col_begin / 2 - 1;
+      long in_len   = (col_end - 1) / 2 - in_begin + 2;
+      for (long t = 0; t < in_len; ++t)
+      {
+        long j = in_begin + t;
+        j = (j < 0) ? std::min(1L, in_size2 - 1) : std::min(j, in_size2 - 1);
+        vcl_size_t x = vcl_size_t(j) * src.pitches.col_pitch;
+        if (row % 2 == 0)
+          buffer[t] = WorkT(r_lo[x]) + WorkT(6) * WorkT(r_mid[x]) + WorkT(r_hi[x]);
+        else
+          buffer[t] = WorkT(4) * (WorkT(r_mid[x]) + WorkT(r_hi[x]));
+      }
+      for (long col = col_begin; col < col_end; ++col)
+      {
+        WorkT const * b = buffer + (col / 2 - in_begin);
+        WorkT sum = (col % 2 == 0) ? b[-1] + WorkT(6) * b[0] + b[1] : WorkT(4) * (b[0] + b[1]);
+        NumericT & o = d[vcl_size_t(col) * dst.pitches.col_pitch];
+        if constexpr (std::is_integral<NumericT>::value)
+        {
+          long value = (sum + 32) >> 6;
+          o = detail::saturate_cast<NumericT>(sign == 0 ? value : long(o) + long(sign) * value);
+        }
+        else
+        {
+          WorkT value = sum * NumericT(1.0 / 64.0);
+          o = (sign == 0) ? value : o + WorkT(sign) * value;
+        }
+      }
+    }
+  }
+}
+
+/** @brief Integral image (summed-area table) and optionally the integral of the squared pixels, sum(i, j) = sum of in(r, c) over r < i, c < j.
+*
+* The tables have one more row and column than the input, the first row and column being zero, so a box sum needs no border test.
+* First every row is scanned independently (rows distributed over threads), then the column scan adds every row to the next one, with blocks of
+* VIENNACL_CONVOLUTION_TILE_COLS columns distributed over threads so that memory is still walked row by row.
+*
+* @param in     Input matrix
+* @param sum    Output table of size (size1(in) + 1) x (size2(in) + 1)
+* @param sqsum  Output table of the squared pixels of the same size, or NULL
+*/
+template<typename InNumericT, typename SumT>
+void integral_image(matrix_base<InNumericT> const & in,
+                    matrix_base<SumT> & sum,
+                    matrix_base<SumT> * sqsum = NULL)
+{
+  detail::channel_array<InNumericT const> src = detail::extract_channel(in);
+  detail::channel_array<SumT>             dst = detail::extract_channel(sum);
+  detail::channel_array<SumT>             dsq = sqsum ? detail::extract_channel(*sqsum) : dst;
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+
+  // row scans:
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = -1; row < size1; ++row)
+  {
+    SumT * d = dst.row(vcl_size_t(row + 1));
+    SumT * q = dsq.row(vcl_size_t(row + 1));
+    if (row < 0)
+    {
+      for (long col = 0; col <= size2; ++col)
+      {
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = SumT(0);
+        if (sqsum) q[vcl_size_t(col) * dsq.pitches.col_pitch] = SumT(0);
+      }
+      continue;
+    }
+    InNumericT const * s = src.row(vcl_size_t(row));
+    SumT running = 0, running_sq = 0;
+    d[0] = SumT(0);
+    if (sqsum) q[0] = SumT(0);
+    for (long col = 0; col < size2; ++col)
+    {
+      SumT value = SumT(s[vcl_size_t(col) * src.pitches.col_pitch]);
+      running += value;
+      d[vcl_size_t(col + 1) * dst.pitches.col_pitch] = running;
+      if (sqsum)
+      {
+        running_sq += value * value;
+        q[vcl_size_t(col + 1) * dsq.pitches.col_pitch] = running_sq;
+      }
+    }
+  }
+
+  // column scans:
+  long const block = VIENNACL_CONVOLUTION_TILE_COLS;
+  long block_num = (size2 + 1 + block - 1) / block;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long b = 0; b < block_num; ++b)
+  {
+    long col_begin = b * block;
+    long col_end   = std::min(col_begin + block, size2 + 1);
+    for (long row = 1; row < size1; ++row)
+    {
+      SumT const * d_prev = dst.row(vcl_size_t(row));
+      SumT       * d      = dst.row(vcl_size_t(row + 1));
+      for (long col = col_begin; col < col_end; ++col)
+        d[vcl_size_t(col) * dst.pitches.col_pitch] += d_prev[vcl_size_t(col) * dst.pitches.col_pitch];
+      if (sqsum)
+      {
+        SumT const * q_prev = dsq.row(vcl_size_t(row));
+        SumT       * q      = dsq.row(vcl_size_t(row + 1));
+        for (long col = col_begin; col < col_end; ++col)
+          q[vcl_size_t(col) * dsq.pitches.col_pitch] += q_prev[vcl_size_t(col) * dsq.pitches.col_pitch];
+      }
+    }
+  }
+}
+
+/** @brief Box sums from integral images in O(1) per pixel: mean (and variance) of the window of size1 x size2 pixels around every pixel, the window origin being ((size1 - 1) / 2, (size2 - 1) / 2) as for convolve.
+*
+* With divide_by_area the sum is divided by size1 * size2 as for a convolution by a normalized all-ones kernel with zero border (box filter).
+* Otherwise it is divided by the number of window pixels inside the image, which gives the mean and the variance of the available pixels (local statistics).
+*
+* @param sum             Integral image from integral_image()
+* @param sqsum           Integral image of the squared pixels, only needed for the variance
+* @param size1           Window rows
+* @param size2           Window columns
+* @param divide_by_area  Divide by the full window area instead of the clipped one
+* @param mean            Output of size (size1(sum) - 1) x (size2(sum) - 1), or NULL
+* @param variance        Output of the same size, E[x^2] - E[x]^2 clamped to 0, or NULL. Nothing is computed if both are NULL.
+*/
+template<typename SumT, typename OutNumericT>
+void box_statistics(matrix_base<SumT> const & sum,
+                    matrix_base<SumT> const * sqsum,
+                    vcl_size_t size1, vcl_size_t size2,
+                    bool divide_by_area,
+                    matrix_base<OutNumericT> * mean,
+                    matrix_base<OutNumericT> * variance = NULL)
+{
+  if (!mean && !variance)
+    return;
+
+  detail::channel_array<SumT const>  s = detail::extract_channel(sum);
+  detail::channel_array<SumT const>  q = sqsum ? detail::extract_channel(*sqsum) : s;
+  detail::channel_array<OutNumericT> m = mean ? detail::extract_channel(*mean) : detail::extract_channel(*variance);
+  detail::channel_array<OutNumericT> v = variance ? detail::extract_channel(*variance) : m;
+
+  long rows = static_cast<long>(viennacl::traits::size1(sum)) - 1;
+  long cols = static_cast<long>(viennacl::traits::size2(sum)) - 1;
+  long before1 = (long(size1) - 1) / 2, after1 = long(size1) / 2;
+  long before2 = (long(size2) - 1) / 2, after2 = long(size2) / 2;
+  double area = double(size1) * double(size2);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((rows*cols) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < rows; ++row)
+  {
+    long r0 = std::max(row - before1, 0L), r1 = std::min(row + after1 + 1, rows);
+    SumT const * s0 = s.row(vcl_size_t(r0)), * s1 = s.row(vcl_size_t(r1));
+    SumT const * q0 = q.row(vcl_size_t(r0)), * q1 = q.row(vcl_size_t(r1));
+    for (long col = 0; col < cols; ++col)
+    {
+      vcl_size_t c0 = vcl_size_t(std::max(col - before2, 0L)), c1 = vcl_size_t(std::min(col + after2 + 1, cols));
+      double box   = double(s1[c1 * s.pitches.col_pitch]) - double(s1[c0 * s.pitches.col_pitch]) - double(s0[c1 * s.pitches.col_pitch]) + double(s0[c0 * s.pitches.col_pitch]);
+      double count = divide_by_area ? area : double(r1 - r0) * double(c1 - c0);
+      double mu    = box / count;
+      if (mean)
+        m.row(vcl_size_t(row))[vcl_size_t(col) * m.pitches.col_pitch] = detail::saturate_cast<OutNumericT>(mu);
+      if (variance)
+      {
+        double box_sq = double(q1[c1 * q.pitches.col_pitch]) - double(q1[c0 * q.pitches.col_pitch]) - double(q0[c1 * q.pitches.col_pitch]) + double(q0[c0 * q.pitches.col_pitch]);
+        v.row(vcl_size_t(row))[vcl_size_t(col) * v.pitches.col_pitch] = detail::saturate_cast<OutNumericT>(std::max(box_sq / count - mu * mu, 0.0));
+      }
+    }
+  }
+}
+
+/** @brief Binary threshold, out(i, j) = (in(i, j) > threshold) ? high : low.
+*
+* @param in         Input matrix
+* @param threshold  Threshold value
+* @param low        Value of the pixels at or below the threshold
+* @param high       Value of the pixels above the threshold
+* @param out        Output matrix of the same size, may be the same object as in
+*/
+template<typename NumericT>
+void threshold(matrix_base<NumericT> const & in,
+               NumericT threshold, NumericT low, NumericT high,
+               matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(out));
+  long size2 = static_cast<long>(viennacl::traits::size2(out));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    NumericT       * d = dst.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+      d[vcl_size_t(col) * dst.pitches.col_pitch] = (s[vcl_size_t(col) * src.pitches.col_pitch] > threshold) ? high : low;
+  }
+}
+
+/** @brief Element-wise saturating addition (sign = 1) or subtraction (sign = -1), out = saturate(in1 + sign * in2).
+*
+* Integer pixels are widened to long inside the loop, so e.g. 200 + 100 gives 255 for unsigned char and 10 - 20 gives 0.
+*
+* @param in1   First operand
+* @param in2   Second operand
+* @param out   Result, may be the same object as in1 or in2
+* @param sign  1 for addition, -1 for subtraction
+*/
+template<typename NumericT>
+void saturating_add(matrix_base<NumericT> const & in1,
+                    matrix_base<NumericT> const & in2,
+                    matrix_base<NumericT> & out,
+                    int sign = 1)
+{
+  typedef typename std::conditional<std::is_integral<NumericT>::value, long, NumericT>::type WideT;
+
+  detail::channel_array<NumericT const> src1 = detail::extract_channel(in1);
+  detail::channel_array<NumericT const> src2 = detail::extract_channel(in2);
+  detail::channel_array<NumericT>       dst  = detail::extract_channel(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(out));
+  long size2 = static_cast<long>(viennacl::traits::size2(out));
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * a = src1.row(vcl_size_t(row));
+    NumericT const * b = src2.row(vcl_size_t(row));
+    NumericT       * d = dst.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+      d[vcl_size_t(col) * dst.pitches.col_pitch]
+        = detail::saturate_cast<NumericT>(WideT(a[vcl_size_t(col) * src1.pitches.col_pitch]) + WideT(sign) * WideT(b[vcl_size_t(col) * src2.pitches.col_pitch]));
+  }
+}
+
+/** @brief Erosion (minimum) or dilation (maximum) over a size1 x size2 rectangle around every pixel, the rectangle origin being ((size1 - 1) / 2, (size2 - 1) / 2) as for convolve. Pixels outside the image are ignored.
+*
+* Separated into a row pass and a column pass, each using the van Herk/Gil-Werman algorithm: the padded line is cut into segments of the
+* element length k, running extrema are computed forward (g) and backward (h) inside every segment, and the extremum of the window starting at x
+* is extremum(h[x], g[x + k - 1]). This costs three comparisons per pixel and pass whatever the element size. The row pass distributes blocks of
+* VIENNACL_CONVOLUTION_TILE_ROWS rows over threads, the column pass blocks of VIENNACL_CONVOLUTION_TILE_COLS columns, whose innermost loops run
+* over contiguous columns so that the compiler vectorizes the minimum and maximum.
+*
+* @param in      Input matrix
+* @param size1   Rows of the structuring element
+* @param size2   Columns of the structuring element
+* @param dilate  Maximum (dilation) instead of minimum (erosion)
+* @param out     Output matrix of the same size, may be the same object as in
+*/
+template<typename NumericT>
+void morphology(matrix_base<NumericT> const & in,
+                vcl_size_t size1, vcl_size_t size2,
+                bool dilate,
+                matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+  detail::channel_array<NumericT const> mid = detail::extract_channel(const_cast<matrix_base<NumericT> const &>(out));
+
+  long rows = static_cast<long>(viennacl::traits::size1(in));
+  long cols = static_cast<long>(viennacl::traits::size2(in));
+  if (rows == 0 || cols == 0)
+    return;
+
+  if (dilate)
+  {
+    detail::van_herk_rows<true>(src, dst, rows, cols, long(size2));
+    if (size1 > 1) detail::van_herk_columns<true>(mid, dst, rows, cols, long(size1));
+  }
+  else
+  {
+    detail::van_herk_rows<false>(src, dst, rows, cols, long(size2));
+    if (size1 > 1) detail::van_herk_columns<false>(mid, dst, rows, cols, long(size1));
+  }
+}
+
+/** @brief Median over the (2 * radius + 1) x (2 * radius + 1) window around every pixel, ignoring the pixels outside the image (the lower median if their number is even).
+*
+* 8-bit pixels use the constant-time histogram algorithm of Perreault and Hebert with strips of columns distributed over threads, so the cost does
+* not depend on the radius (radius at most 127). Other pixel types select the median of every window with std::nth_element, rows distributed over threads.
+*
+* @param in      Input matrix
+* @param radius  Window radius
+* @param out     Output matrix of the same size, must not be the same object as in
+*/
+template<typename NumericT>
+void median(matrix_base<NumericT> const & in,
+            vcl_size_t radius,
+            matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long r = static_cast<long>(radius);
+
+  if constexpr (std::is_same<NumericT, unsigned char>::value)
+    detail::median_histogram_u8(src, dst, size1, size2, r);
+  else
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+    for (long row = 0; row < size1; ++row)
+    {
+      std::vector<NumericT> window;
+      window.reserve(vcl_size_t((2 * r + 1) * (2 * r + 1)));
+      NumericT * d = dst.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+      {
+        window.clear();
+        for (long i = std::max(row - r, 0L); i <= std::min(row + r, size1 - 1); ++i)
+        {
+          NumericT const * s = src.row(vcl_size_t(i));
+          for (long j = std::max(col - r, 0L); j <= std::min(col + r, size2 - 1); ++j)
+            window.push_back(s[vcl_size_t(j) * src.pitches.col_pitch]);
+        }
+        typename std::vector<NumericT>::iterator mid = window.begin() + (window.size() - 1) / 2;
+        std::nth_element(window.begin(), mid, window.end());
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = *mid;
+      }
+    }
+  }
+}
+
+/** @brief Bilateral filter through a bilateral grid (Chen, Paris and Durand), in constant time per pixel whatever the spatial extent.
+*
+* Every pixel is accumulated (value, 1) into the nearest cell of a 3D grid of sigma_space x sigma_space pixels by sigma_range intensity levels,
+* the grid is blurred by [1 4 6 4 1] / 16 along its three axes, and the output is the ratio of the two channels interpolated trilinearly at
+* the pixel position and value. The accumulation distributes grid rows over threads, the blur grid lines and the interpolation image rows.
+*
+* @param in           Input matrix
+* @param sigma_space  Spatial standard deviation in pixels, at least 1
+* @param sigma_range  Range standard deviation in units of the pixel values, e.g. 0.1 for float pixels in [0, 1] or 25 for 8-bit pixels
+* @param out          Output matrix of the same size, may be the same object as in
+*/
+template<typename NumericT>
+void bilateral_grid(matrix_base<NumericT> const & in,
+                    double sigma_space, double sigma_range,
+                    matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  if (size1 == 0 || size2 == 0)
+    return;
+
+  double lo = double(src.row(0)[0]), hi = lo;
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(min:lo) reduction(max:hi) if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+    {
+      double v = double(s[vcl_size_t(col) * src.pitches.col_pitch]);
+      lo = std::min(lo, v);
+      hi = std::max(hi, v);
+    }
+  }
+
+  long const pad = 2;    // room for the 5-tap blur
+  double space = std::max(sigma_space, 1.0);
+  double range = (sigma_range > 0) ? sigma_range : 1.0;
+  long gh = long((size1 - 1) / space + 0.5) + 1 + 2 * pad;
+  long gw = long((size2 - 1) / space + 0.5) + 1 + 2 * pad;
+  long gd = long((hi - lo) / range + 0.5) + 1 + 2 * pad;
+  std::vector<float> grid(vcl_size_t(gh * gw * gd * 2), 0.0f);
+
+  // accumulation, the pixel rows of one grid row [first_row[gy], first_row[gy + 1]) belong to a single thread
+  std::vector<long> first_row(vcl_size_t(gh + 1), size1);
+  for (long row = size1 - 1; row >= 0; --row)
+    first_row[vcl_size_t(long(row / space + 0.5) + pad)] = row;
+  for (long gy = gh - 1; gy >= 0; --gy)
+    first_row[vcl_size_t(gy)] = std::min(first_row[vcl_size_t(gy)], first_row[vcl_size_t(gy + 1)]);
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long gy = 0; gy < gh; ++gy)
+    for (long row = first_row[vcl_size_t(gy)]; row < first_row[vcl_size_t(gy + 1)]; ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+      {
+        double v = double(s[vcl_size_t(col) * src.pitches.col_pitch]);
+        long gx = long(col / space + 0.5) + pad;
+        long gz = long((v - lo) / range + 0.5) + pad;
+        float * cell = &grid[vcl_size_t(((gy * gw + gx) * gd + gz) * 2)];
+        cell[0] += float(v);
+        cell[1] += 1.0f;
+      }
+    }
+
+  detail::blur_grid_axis(grid, gh * gw, 1,       gd * 2,      0, gd, 2);
+  detail::blur_grid_axis(grid, gh * gd, gd,      gw * gd * 2, 2, gw, gd * 2);
+  detail::blur_grid_axis(grid, gw * gd, gw * gd, 0,           2, gh, gw * gd * 2);
+
+  // trilinear interpolation
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    NumericT       * d = dst.row(vcl_size_t(row));
+    double fy = row / space + pad;
+    long   y0 = std::min(long(fy), gh - 2);
+    double wy = fy - y0;
+    for (long col = 0; col < size2; ++col)
+    {
+      double v  = double(s[vcl_size_t(col) * src.pitches.col_pitch]);
+      double fx = col / space + pad,    fz = (v - lo) / range + pad;
+      long   x0 = std::min(long(fx), gw - 2), z0 = std::min(long(fz), gd - 2);
+      double wx = fx - x0,              wz = fz - z0;
+      double acc[2] = { 0.0, 0.0 };
+      for (long i = 0; i < 2; ++i)
+      for (long j = 0; j < 2; ++j)
+      for (long k = 0; k < 2; ++k)
+      {
+        double w = (i ? wy : 1.0 - wy) * (j ? wx : 1.0 - wx) * (k ? wz : 1.0 - wz);
+        float const * cell = &grid[vcl_size_t((((y0 + i) * gw + x0 + j) * gd + z0 + k) * 2)];
+        acc[0] += w * cell[0];
+        acc[1] += w * cell[1];
+      }
+      d[vcl_size_t(col) * dst.pitches.col_pitch] = (acc[1] > 0) ? detail::saturate_cast<NumericT>(acc[0] / acc[1]) : NumericT(v);
+    }
+  }
+}
+
+/** @brief Non-maximum suppression and double threshold of a Canny detector. A pixel is kept if its gradient magnitude is a maximum along the quantized
+* gradient direction (pixels outside of the image count as zero), and is then labeled 2 (strong) above 'high', 1 (weak) above 'low' and 0 otherwise.
+*
+* @param magnitude    Gradient magnitude, see sobel_gradient
+* @param orientation  Gradient direction quantized to 0, 45, 90 or 135 degrees (0 to 3), see sobel_gradient with orientation_bins = 4
+* @param low          Lower threshold
+* @param high         Upper threshold
+* @param labels       Output labels of the same size
+*/
+template<typename NumericT>
+void canny_suppress(matrix_base<NumericT> const & magnitude,
+                    matrix_base<NumericT> const & orientation,
+                    NumericT low, NumericT high,
+                    matrix_base<unsigned char> & labels)
+{
+  detail::channel_array<NumericT const> mag = detail::extract_channel(magnitude);
+  detail::channel_array<NumericT const> ori = detail::extract_channel(orientation);
+  detail::channel_array<unsigned char>  lab = detail::extract_channel(labels);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(magnitude));
+  long size2 = static_cast<long>(viennacl::traits::size2(magnitude));
+  // neighbour offsets (row, column) along the directions 0, 45, 90 and 135 degrees, the y axis pointing up as for sobel_gradient
+  long const step_row[4] = { 0, -1, -1, -1 };
+  long const step_col[4] = { 1,  1,  0, -1 };
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * m = mag.row(vcl_size_t(row));
+    NumericT const * o = ori.row(vcl_size_t(row));
+    unsigned char  * l = lab.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+    {
+      NumericT value = m[vcl_size_t(col) * mag.pitches.col_pitch];
+      unsigned char label = 0;
+      if (value > low)
+      {
+        long dir = long(o[vcl_size_t(col) * ori.pitches.col_pitch]) & 3;
+        long r1 = row + step_row[dir], c1 = col + step_col[dir];
+        long r2 = row - step_row[dir], c2 = col - step_col[dir];
+        NumericT n1 = (r1 >= 0 && r1 < size1 && c1 >= 0 && c1 < size2) ? mag.row(vcl_size_t(r1))[vcl_size_t(c1) * mag.pitches.col_pitch] : NumericT(0);
+        NumericT n2 = (r2 >= 0 && r2 < size1 && c2 >= 0 && c2 < size2) ? mag.row(vcl_size_t(r2))[vcl_size_t(c2) * mag.pitches.col_pitch] : NumericT(0);
+        // ties are broken towards the first neighbour so that a plateau keeps a single pixel across the edge
+        if (value > n1 && value >= n2)
+          label = (value > high) ? 2 : 1;
+      }
+      l[vcl_size_t(col) * lab.pitches.col_pitch] = label;
+    }
+  }
+}
+
+/** @brief Hysteresis of a Canny detector: weak pixels (label 1) 8-connected to a strong pixel (label 2) become strong, then strong pixels are written as 'edge' and the others as 0.
+*
+* The labels are cut into tiles of VIENNACL_CONVOLUTION_TILE_ROWS x VIENNACL_CONVOLUTION_TILE_COLS pixels. Every tile first grows its strong pixels
+* inside the tile by a depth-first search, tiles distributed over threads. Then, as long as some weak pixel on a tile border touches a strong pixel of
+* a neighbouring tile, those pixels are collected (read only) and grown inside their tiles in a second parallel pass, so no two threads write the same tile.
+*
+* @param labels  Labels from canny_suppress, updated in place
+* @param stacks  Search stacks, one per tile, resized as needed and reusable for the next image of the same size
+* @param edge    Output value of edge pixels
+* @param out     Output edge map of the same size
+*/
+template<typename NumericT>
+void canny_hysteresis(matrix_base<unsigned char> & labels,
+                      std::vector<std::vector<long> > & stacks,
+                      NumericT edge,
+                      matrix_base<NumericT> & out)
+{
+  detail::channel_array<unsigned char> lab = detail::extract_channel(labels);
+  detail::channel_array<NumericT>      dst = detail::extract_channel(out);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(labels));
+  long size2 = static_cast<long>(viennacl::traits::size2(labels));
+  long const tile_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long const tile_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long tiles1 = (size1 + tile_rows - 1) / tile_rows;
+  long tiles2 = (size2 + tile_cols - 1) / tile_cols;
+  long tile_num = tiles1 * tiles2;
+  stacks.resize(vcl_size_t(tile_num));
+
+  // initial growth: seed every tile with its strong pixels
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long tile = 0; tile < tile_num; ++tile)
+  {
+    long row_begin = (tile / tiles2) * tile_rows, row_end = std::min(row_begin + tile_rows, size1);
+    long col_begin = (tile % tiles2) * tile_cols, col_end = std::min(col_begin + tile_cols, size2);
+    std::vector<long> & stack = stacks[vcl_size_t(tile)];
+    stack.clear();
+    for (long row = row_begin; row < row_end; ++row)
+      for (long col = col_begin; col < col_end; ++col)
+        if (lab.row(vcl_size_t(row))[vcl_size_t(col) * lab.pitches.col_pitch] == 2)
+          stack.push_back(row * size2 + col);
+    detail::grow_in_tile(lab, stack, row_begin, row_end, col_begin, col_end, size2);
+  }
+
+  // propagation across tile borders until no tile changes
+  long seed_num = 1;
+  while (seed_num > 0)
+  {
+    seed_num = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+:seed_num) if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+    for (long tile = 0; tile < tile_num; ++tile)
+    {
+      long row_begin = (tile / tiles2) * tile_rows, row_end = std::min(row_begin + tile_rows, size1);
+      long col_begin = (tile % tiles2) * tile_cols, col_end = std::min(col_begin + tile_cols, size2);
+      std::vector<long> & stack = stacks[vcl_size_t(tile)];
+      for (long row = row_begin; row < row_end; ++row)
+      {
+        // the first and last rows of the tile entirely, the first and last columns of the other rows
+        long step = ((row == row_begin) || (row == row_end - 1)) ? 1 : std::max(col_end - col_begin - 1, 1L);
+        for (long col = col_begin; col < col_end; col += step)
+        {
+          if (lab.row(vcl_size_t(row))[vcl_size_t(col) * lab.pitches.col_pitch] != 1)
+            continue;
+          bool touched = false;
+          for (long r = std::max(row - 1, 0L); r <= std::min(row + 1, size1 - 1) && !touched; ++r)
+            for (long c = std::max(col - 1, 0L); c <= std::min(col + 1, size2 - 1); ++c)
+              if ((r < row_begin || r >= row_end || c < col_begin || c >= col_end) && lab.row(vcl_size_t(r))[vcl_size_t(c) * lab.pitches.col_pitch] == 2)
+              {
+                touched = true;
+                break;
+              }
+          if (touched)
+            stack.push_back(row * size2 + col);
+        }
+      }
+      seed_num += long(stack.size());
+    }
+    if (seed_num == 0)
+      break;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+    for (long tile = 0; tile < tile_num; ++tile)
+    {
+      long row_begin = (tile / tiles2) * tile_rows, row_end = std::min(row_begin + tile_rows, size1);
+      long col_begin = (tile % tiles2) * tile_cols, col_end = std::min(col_begin + tile_cols, size2);
+      std::vector<long> & stack = stacks[vcl_size_t(tile)];
+      for (long index: stack)
+        lab.row(vcl_size_t(index / size2))[vcl_size_t(index % size2) * lab.pitches.col_pitch] = 2;
+      detail::grow_in_tile(lab, stack, row_begin, row_end, col_begin, col_end, size2);
+    }
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    unsigned char const * l = lab.row(vcl_size_t(row));
+    NumericT            * d = dst.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+      d[vcl_size_t(col) * dst.pitches.col_pitch] = (l[vcl_size_t(col) * lab.pitches.col_pitch] == 2) ? edge : NumericT(0);
+  }
+}
+
+/** @brief Statistics of one connected component, see connected_components() */
+struct component_statistics
+{
+  vcl_size_t area;
+  long       row_min, row_max, col_min, col_max;     // bounding box, inclusive
+  double     row_sum, col_sum;                       // divided by area for the centroid
+};
+
+/** @brief Connected-component labeling of a mask (non-zero pixels are foreground) with statistics of every component.
+*
+* Block-based union-find: strips of VIENNACL_CONVOLUTION_TILE_ROWS rows are labeled independently by threads, every pixel starting as its own set in
+* a forest over the pixel indices, and the sets of adjacent pixels are merged so that the root of a set is its first pixel in raster order. The strip
+* borders are then merged, the roots are numbered in raster order from 1 (strips count their roots in parallel, followed by a prefix sum), and the final
+* pass writes the labels while every thread accumulates area, bounding box and centroid sums of the components it meets. Background pixels get label 0.
+*
+* @param mask          Input mask
+* @param connectivity  4 or 8
+* @param parent        Union-find forest, resized to the number of pixels, reusable for the next mask
+* @param labels        Output labels of the same size
+* @param stats         Statistics of components 1, 2, ... at entries 0, 1, ..., or NULL
+* @return              Number of components
+*/
+template<typename NumericT, typename LabelT>
+vcl_size_t connected_components(matrix_base<NumericT> const & mask,
+                                unsigned int connectivity,
+                                std::vector<long> & parent,
+                                matrix_base<LabelT> & labels,
+                                std::vector<component_statistics> * stats = NULL)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(mask);
+  detail::channel_array<LabelT>         dst = detail::extract_channel(labels);
+
+  long size1 = static_cast<long>(viennacl::traits::size1(mask));
+  long size2 = static_cast<long>(viennacl::traits::size2(mask));
+  long const strip_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long strip_num = (size1 + strip_rows - 1) / strip_rows;
+  bool diagonal = (connectivity == 8);
+  parent.resize(vcl_size_t(size1 * size2));
+  std::vector<long> root_offset(vcl_size_t(strip_num + 1), 0);
+
+  // local labeling of every strip, only touching the pixels of the strip
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long strip = 0; strip < strip_num; ++strip)
+  {
+    long row_begin = strip * strip_rows, row_end = std::min(row_begin + strip_rows, size1);
+    for (long row = row_begin; row < row_end; ++row)
+    {
+      NumericT const * s  = src.row(vcl_size_t(row));
+      NumericT const * up = (row > row_begin) ? src.row(vcl_size_t(row - 1)) : NULL;
+      for (long col = 0; col < size2; ++col)
+      {
+        long i = row * size2 + col;
+        parent[vcl_size_t(i)] = i;
+        if (s[vcl_size_t(col) * src.pitches.col_pitch] == NumericT(0))
+          continue;
+        if (col > 0 && s[vcl_size_t(col - 1) * src.pitches.col_pitch] != NumericT(0))
+          detail::unite(parent, i, i - 1);
+        if (up)
+        {
+          for (long c = (diagonal ? col - 1 : col); c <= (diagonal ? col + 1 : col); ++c)
+            if (c >= 0 && c < size2 && up[vcl_size_t(c) * src.pitches.col_pitch] != NumericT(0))
+              detail::unite(parent, i, i - size2 + (c - col));
+        }
+      }
+    }
+  }
+
+  // strip borders
+  for (long strip = 1; strip < strip_num; ++strip)
+  {
+    long row = strip * strip_rows;
+    NumericT const * s  = src.row(vcl_size_t(row));
+    NumericT const * up = src.row(vcl_size_t(row - 1));
+    for (long col = 0; col < size2; ++col)
+    {
+      if (s[vcl_size_t(col) * src.pitches.col_pitch] == NumericT(0))
+        continue;
+      for (long c = (diagonal ? col - 1 : col); c <= (diagonal ? col + 1 : col); ++c)
+        if (c >= 0 && c < size2 && up[vcl_size_t(c) * src.pitches.col_pitch] != NumericT(0))
+          detail::unite(parent, row * size2 + col, (row - 1) * size2 + c);
+    }
+  }
+
+  // number the roots in raster order: count per strip, prefix sum, then flatten every pixel to its root and mark roots with their label
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long strip = 0; strip < strip_num; ++strip)
+  {
+    long count = 0;
+    for (long row = strip * strip_rows; row < std::min((strip + 1) * strip_rows, size1); ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+        if (s[vcl_size_t(col) * src.pitches.col_pitch] != NumericT(0) && parent[vcl_size_t(row * size2 + col)] == row * size2 + col)
+          ++count;
+    }
+    root_offset[vcl_size_t(strip + 1)] = count;
+  }
+  for (long strip = 0; strip < strip_num; ++strip)
+    root_offset[vcl_size_t(strip + 1)] += root_offset[vcl_size_t(strip)];
+  vcl_size_t component_num = vcl_size_t(root_offset[vcl_size_t(strip_num)]);
+
+  // roots are stored as -label to tell them from pixel indices
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long strip = 0; strip < strip_num; ++strip)
+  {
+    long next = root_offset[vcl_size_t(strip)];
+    for (long row = strip * strip_rows; row < std::min((strip + 1) * strip_rows, size1); ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+      {
+        long i = row * size2 + col;
+        if (s[vcl_size_t(col) * src.pitches.col_pitch] != NumericT(0) && parent[vcl_size_t(i)] == i)
+          parent[vcl_size_t(i)] = -(++next);
+      }
+    }
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  {
+    std::vector<component_statistics> local(stats ? component_num : 0);
+    for (component_statistics & entry: local)
+      entry = component_statistics{0, size1, -1, size2, -1, 0.0, 0.0};
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long row = 0; row < size1; ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      LabelT         * d = dst.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+      {
+        long label = 0;
+        if (s[vcl_size_t(col) * src.pitches.col_pitch] != NumericT(0))
+        {
+          // the root is labeled (negative), so following the parents without compression needs no write
+          long i = row * size2 + col;
+          while (parent[vcl_size_t(i)] >= 0)
+            i = parent[vcl_size_t(i)];
+          label = -parent[vcl_size_t(i)];
+          if (stats)
+          {
+            component_statistics & entry = local[vcl_size_t(label - 1)];
+            entry.area    += 1;
+            entry.row_min  = std::min(entry.row_min, row);
+            entry.row_max  = std::max(entry.row_max, row);
+            entry.col_min  = std::min(entry.col_min, col);
+            entry.col_max  = std::max(entry.col_max, col);
+            entry.row_sum += double(row);
+            entry.col_sum += double(col);
+          }
+        }
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = LabelT(label);
+      }
+    }
+
+    if (stats)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp single
+#endif
+      stats->assign(component_num, component_statistics{0, size1, -1, size2, -1, 0.0, 0.0});
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical
+#endif
+      for (vcl_size_t k = 0; k < component_num; ++k)
+      {
+        component_statistics & entry = (*stats)[k];
+        entry.area    += local[k].area;
+        entry.row_min  = std::min(entry.row_min, local[k].row_min);
+        entry.row_max  = std::max(entry.row_max, local[k].row_max);
+        entry.col_min  = std::min(entry.col_min, local[k].col_min);
+        entry.col_max  = std::max(entry.col_max, local[k].col_max);
+        entry.row_sum += local[k].row_sum;
+        entry.col_sum += local[k].col_sum;
+      }
+    }
+  }
+  return component_num;
+}
+
+/** @brief Histogram of 'bins' equal bins over [lo, hi], pixels outside of the interval being ignored and hi falling into the last bin.
+*
+* Every thread counts its rows into a private bin array, and the arrays are added up at the end, so the counting loop has no atomic operation.
+*
+* @param in      Input matrix
+* @param bins    Number of bins
+* @param lo      Lower end of the first bin
+* @param hi      Upper end of the last bin
+* @param counts  Output counts, resized to bins
+*/
+template<typename NumericT>
+void histogram(matrix_base<NumericT> const & in,
+               vcl_size_t bins, double lo, double hi,
+               std::vector<vcl_size_t> & counts)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long bin_num = static_cast<long>(bins);
+  double scale = double(bins) / (hi - lo);
+  counts.assign(bins, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  {
+    std::vector<vcl_size_t> local(bins, 0);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long row = 0; row < size1; ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      for (long col = 0; col < size2; ++col)
+      {
+        double v = double(s[vcl_size_t(col) * src.pitches.col_pitch]);
+        if (v >= lo && v <= hi)
+          ++local[vcl_size_t(detail::histogram_bin(v, lo, scale, bin_num))];
+      }
+    }
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp critical
+#endif
+    for (vcl_size_t b = 0; b < bins; ++b)
+      counts[b] += local[b];
+  }
+}
+
+/** @brief Map every pixel through a cumulative distribution, out = pixel_range * cdf(in), e.g. for histogram equalization.
+*
+* @param in     Input matrix
+* @param edges  Cumulative distribution in [0, 1] at the bins + 1 bin edges of the histogram over [lo, hi], see histogram()
+* @param lo     Lower end of the first bin
+* @param hi     Upper end of the last bin
+* @param out    Output matrix of the same size, may be the same object as in
+*/
+template<typename NumericT>
+void apply_cumulative(matrix_base<NumericT> const & in,
+                      std::vector<double> const & edges, double lo, double hi,
+                      matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long bins = static_cast<long>(edges.size()) - 1;
+  double range = detail::pixel_range<NumericT>();
+  detail::cumulative_tables<NumericT> cumulative(edges, bins, lo, hi);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    NumericT       * d = dst.row(vcl_size_t(row));
+    for (long col = 0; col < size2; ++col)
+      d[vcl_size_t(col) * dst.pitches.col_pitch] = detail::saturate_cast<NumericT>(range * cumulative(0, s[vcl_size_t(col) * src.pitches.col_pitch]));
+  }
+}
+
+/** @brief Contrast limited adaptive histogram equalization (CLAHE).
+*
+* The image is cut into tiles1 x tiles2 tiles, and the tiles build their clipped and equalized cumulative distributions in parallel: the histogram is clipped
+* at clip_limit times the mean bin count and the excess spread uniformly over the bins. Every pixel is then mapped through the distributions of the four
+* nearest tile centers, weighted bilinearly with per-row and per-column weight tables, rows distributed over threads.
+*
+* @param in          Input matrix
+* @param tiles1      Tile rows
+* @param tiles2      Tile columns
+* @param clip_limit  Clip limit relative to the mean bin count, e.g. 2 to 4, 0 for no clipping
+* @param bins        Number of histogram bins over [lo, hi]
+* @param lo          Lower end of the first bin
+* @param hi          Upper end of the last bin
+* @param out         Output matrix of the same size, may be the same object as in
+*/
+template<typename NumericT>
+void clahe(matrix_base<NumericT> const & in,
+           vcl_size_t tiles1, vcl_size_t tiles2,
+           double clip_limit,
+           vcl_size_t bins, double lo, double hi,
+           matrix_base<NumericT> & out)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+  long size1 = static_cast<long>(viennacl::traits::size1(in));
+  long size2 = static_cast<long>(viennacl::traits::size2(in));
+  long t1 = std::max(std::min(long(tiles1), size1), 1L), t2 = std::max(std::min(long(tiles2), size2), 1L);
+  long tile_rows = (size1 + t1 - 1) / t1, tile_cols = (size2 + t2 - 1) / t2;
+  // NOTE Rounding the tile size up can leave trailing tiles empty (10 rows in 8 tiles of 2 rows), whose all-zero tables would be blended into the edge pixels.
+  t1 = (size1 + tile_rows - 1) / tile_rows;
+  t2 = (size2 + tile_cols - 1) / tile_cols;
+  long bin_num = static_cast<long>(bins);
+  double scale = double(bins) / (hi - lo);
+  double range = detail::pixel_range<NumericT>();
+  std::vector<double> edges(vcl_size_t(t1 * t2 * (bin_num + 1)));
+
+  // cumulative distribution of every tile
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long tile = 0; tile < t1 * t2; ++tile)
+  {
+    long row_begin = (tile / t2) * tile_rows, row_end = std::min(row_begin + tile_rows, size1);
+    long col_begin = (tile % t2) * tile_cols, col_end = std::min(col_begin + tile_cols, size2);
+    std::vector<double> hist(vcl_size_t(bin_num), 0.0);
+    for (long row = row_begin; row < row_end; ++row)
+    {
+      NumericT const * s = src.row(vcl_size_t(row));
+      for (long col = col_begin; col < col_end; ++col)
+        hist[vcl_size_t(detail::histogram_bin(s[vcl_size_t(col) * src.pitches.col_pitch], lo, scale, bin_num))] += 1.0;
+    }
+    double pixels = double(std::max(row_end - row_begin, 0L) * std::max(col_end - col_begin, 0L));
+    if (clip_limit > 0)
+    {
+      double limit = std::max(clip_limit * pixels / double(bin_num), 1.0), excess = 0;
+      for (double & h: hist)
+        if (h > limit)
+        {
+          excess += h - limit;
+          h = limit;
+        }
+      for (double & h: hist)
+        h += excess / double(bin_num);
+    }
+    double * e = &edges[vcl_size_t(tile * (bin_num + 1))];
+    e[0] = 0;
+    for (long b = 0; b < bin_num; ++b)
+      e[b + 1] = e[b] + hist[vcl_size_t(b)] / std::max(pixels, 1.0);
+  }
+
+  // bilinear weights between the tile centers, per row and per column
+  detail::cumulative_tables<NumericT> cumulative(edges, bin_num, lo, hi);
+  std::vector<long> row_tile(static_cast<vcl_size_t>(size1)), col_tile(static_cast<vcl_size_t>(size2));
+  std::vector<double> row_weight(static_cast<vcl_size_t>(size1)), col_weight(static_cast<vcl_size_t>(size2));
+  for (long row = 0; row < size1; ++row)
+  {
+    double f = (double(row) + 0.5) / double(tile_rows) - 0.5;
+    row_tile[vcl_size_t(row)]   = std::min(std::max(long(std::floor(f)), 0L), t1 - 1);
+    row_weight[vcl_size_t(row)] = std::min(std::max(f - double(row_tile[vcl_size_t(row)]), 0.0), 1.0);
+  }
+  for (long col = 0; col < size2; ++col)
+  {
+    double f = (double(col) + 0.5) / double(tile_cols) - 0.5;
+    col_tile[vcl_size_t(col)]   = std::min(std::max(long(std::floor(f)), 0L), t2 - 1);
+    col_weight[vcl_size_t(col)] = std::min(std::max(f - double(col_tile[vcl_size_t(col)]), 0.0), 1.0);
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((size1*size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    NumericT       * d = dst.row(vcl_size_t(row));
+    long   ty0 = row_tile[vcl_size_t(row)], ty1 = std::min(ty0 + 1, t1 - 1);
+    double wy  = row_weight[vcl_size_t(row)];
+    for (long col = 0; col < size2; ++col)
+    {
+      NumericT v = s[vcl_size_t(col) * src.pitches.col_pitch];
+      long   tx0 = col_tile[vcl_size_t(col)], tx1 = std::min(tx0 + 1, t2 - 1);
+      double wx  = col_weight[vcl_size_t(col)];
+      double c00 = cumulative(ty0 * t2 + tx0, v);
+      double c01 = cumulative(ty0 * t2 + tx1, v);
+      double c10 = cumulative(ty1 * t2 + tx0, v);
+      double c11 = cumulative(ty1 * t2 + tx1, v);
+      double c = (1 - wy) * ((1 - wx) * c00 + wx * c01) + wy * ((1 - wx) * c10 + wx * c11);
+      d[vcl_size_t(col) * dst.pitches.col_pitch] = detail::saturate_cast<NumericT>(range * c);
+    }
+  }
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,410 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_WARP_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_WARP_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file  viennacl/linalg/host_based/warp_operations.hpp
+    @brief Implementations of geometric image transformations (resize, affine and perspective warps, remapping), using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+// Fraction bits of the fixed-point bilinear weights of integer pixels:
+#ifndef VIENNACL_WARP_FRACTION_BITS
+  #define VIENNACL_WARP_FRACTION_BITS  10
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+namespace detail
+{
+
+/** @brief Cubic convolution weights of the four taps at -1, 0, 1, 2 for a fraction f in [0, 1) (Keys, a = -0.5) */
+inline void cubic_weights(double f, double w[4])
+{
+  double const a = -0.5;
+  double d[4] = { 1.0 + f, f, 1.0 - f, 2.0 - f };
+  for (int k = 0; k < 4; ++k)
+  {
+    double x = d[k];
+    w[k] = (x <= 1.0) ? ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0
+                      : ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+  }
+}
+
+/** @brief Sample a channel at the real position (y, x), pixel centers at integer positions. Taps outside of the image read 'border'.
+* Integer pixels are interpolated bilinearly in fixed point with VIENNACL_WARP_FRACTION_BITS bits per weight, bicubic in double.
+*
+* Positions are range-checked as doubles before they are converted to indices, so huge and non-finite positions (NaN fails every comparison) read the border
+* instead of overflowing the conversion.
+*/
+template<viennacv::interpolation Interpolation, typename NumericT>
+inline NumericT sample(channel_array<NumericT const> const & src, long size1, long size2, double y, double x, NumericT border)
+{
+  if (Interpolation == viennacv::NEAREST)
+  {
+    if (!(y >= -0.5 && y < double(size1) - 0.5 && x >= -0.5 && x < double(size2) - 0.5))
+      return border;
+    long r = long(std::floor(y + 0.5)), c = long(std::floor(x + 0.5));
+    return src.row(vcl_size_t(r))[vcl_size_t(c) * src.pitches.col_pitch];
+  }
+
+  // some tap of the bilinear (bicubic) stencil lies inside of the image iff floor(y) is in [-1, size1) ([-2, size1])
+  double reach = (Interpolation == viennacv::BICUBIC) ? 2.0 : 1.0;
+  if (!(y >= -reach && y < double(size1) + reach - 1.0 && x >= -reach && x < double(size2) + reach - 1.0))
+    return border;
+  long r0 = long(std::floor(y)), c0 = long(std::floor(x));
+  double fy = y - double(r0), fx = x - double(c0);
+  if (Interpolation == viennacv::BILINEAR)
+  {
+    NumericT p[4];
+    for (long i = 0; i < 2; ++i)
+      for (long j = 0; j < 2; ++j)
+      {
+        long r = r0 + i, c = c0 + j;
+        p[2 * i + j] = (r >= 0 && r < size1 && c >= 0 && c < size2) ? src.row(vcl_size_t(r))[vcl_size_t(c) * src.pitches.col_pitch] : border;
+      }
+    if constexpr (std::is_integral<NumericT>::value)
+    {
+      long long const one = 1LL << VIENNACL_WARP_FRACTION_BITS;
+      long long wy = (long long)(fy * double(one) + 0.5), wx = (long long)(fx * double(one) + 0.5);
+      long long acc = (one - wy) * ((one - wx) * p[0] + wx * p[1]) + wy * ((one - wx) * p[2] + wx * p[3]);
+      return saturate_cast<NumericT>((acc + (1LL << (2 * VIENNACL_WARP_FRACTION_BITS - 1))) >> (2 * VIENNACL_WARP_FRACTION_BITS));
+    }
+    else
+      return NumericT((1 - fy) * ((1 - fx) * p[0] + fx * p[1]) + fy * ((1 - fx) * p[2] + fx * p[3]));
+  }
+
+  // bicubic
+  double wy[4], wx[4];
+  cubic_weights(fy, wy);
+  cubic_weights(fx, wx);
+  double acc = 0;
+  for (long i = 0; i < 4; ++i)
+  {
+    long r = r0 - 1 + i;
+    double line = 0;
+    for (long j = 0; j < 4; ++j)
+    {
+      long c = c0 - 1 + j;
+      NumericT p = (r >= 0 && r < size1 && c >= 0 && c < size2) ? src.row(vcl_size_t(r))[vcl_size_t(c) * src.pitches.col_pitch] : border;
+      line += wx[j] * double(p);
+    }
+    acc += wy[i] * line;
+  }
+  return saturate_cast<NumericT>(acc);
+}
+
+/** @brief Run a warp over tiles of VIENNACL_CONVOLUTION_TILE_ROWS x VIENNACL_CONVOLUTION_TILE_COLS output pixels distributed over threads.
+* 'coordinates(row, col_begin, col_end, ys, xs)' fills the source positions of a row segment of the tile. */
+template<viennacv::interpolation Interpolation, typename NumericT, typename CoordinatesT>
+void warp_tiles(matrix_base<NumericT> const & in, matrix_base<NumericT> & out, NumericT border, CoordinatesT const & coordinates)
+{
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+
+  long in_size1  = static_cast<long>(viennacl::traits::size1(in));
+  long in_size2  = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  long const tile_rows = VIENNACL_CONVOLUTION_TILE_ROWS;
+  long const tile_cols = VIENNACL_CONVOLUTION_TILE_COLS;
+  long tiles2 = (out_size2 + tile_cols - 1) / tile_cols;
+  long tile_num = ((out_size1 + tile_rows - 1) / tile_rows) * tiles2;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long tile = 0; tile < tile_num; ++tile)
+  {
+    long row_begin = (tile / tiles2) * tile_rows, row_end = std::min(row_begin + tile_rows, out_size1);
+    long col_begin = (tile % tiles2) * tile_cols, col_end = std::min(col_begin + tile_cols, out_size2);
+    double ys[VIENNACL_CONVOLUTION_TILE_COLS], xs[VIENNACL_CONVOLUTION_TILE_COLS];
+    for (long row = row_begin; row < row_end; ++row)
+    {
+      coordinates(row, col_begin, col_end, ys, xs);
+      NumericT * d = dst.row(vcl_size_t(row));
+      for (long col = col_begin; col < col_end; ++col)
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = sample<Interpolation>(src, in_size1, in_size2, ys[col - col_begin], xs[col - col_begin], border);
+    }
+  }
+}
+
+/** @brief Instantiate warp_tiles for the interpolation. AREA has no meaning for a pointwise map and is sampled bilinearly. */
+template<typename NumericT, typename CoordinatesT>
+void warp_dispatch(matrix_base<NumericT> const & in, matrix_base<NumericT> & out, viennacv::interpolation interpolation, NumericT border, CoordinatesT const & coordinates)
+{
+  switch (interpolation)
+  {
+    case viennacv::NEAREST: warp_tiles<viennacv::NEAREST>(in, out, border, coordinates);  break;
+    case viennacv::BICUBIC: warp_tiles<viennacv::BICUBIC>(in, out, border, coordinates);  break;
+    default:                warp_tiles<viennacv::BILINEAR>(in, out, border, coordinates); break;
+  }
+}
+
+/** @brief Taps of a 1-D resampling from in_size to out_size samples, a fixed number of (index, weight) pairs per output sample, the indices clamped to the input (replicated border). Pixel centers are aligned, source = (dest + 0.5) * in_size / out_size - 0.5. */
+struct resample_table
+{
+  long                taps;
+  std::vector<long>   index;
+  std::vector<double> weight;
+
+  resample_table(long in_size, long out_size, viennacv::interpolation interpolation) : taps(1)
+  {
+    double scale = double(in_size) / double(out_size);
+    if (interpolation == viennacv::AREA && scale <= 1.0)
+      interpolation = viennacv::BILINEAR;
+    if (interpolation == viennacv::BILINEAR) taps = 2;
+    if (interpolation == viennacv::BICUBIC)  taps = 4;
+    if (interpolation == viennacv::AREA)     taps = long(std::ceil(scale)) + 1;
+    index.assign(vcl_size_t(out_size * taps), 0);
+    weight.assign(vcl_size_t(out_size * taps), 0.0);
+
+    for (long o = 0; o < out_size; ++o)
+    {
+      long   * ix = &index[vcl_size_t(o * taps)];
+      double * wt = &weight[vcl_size_t(o * taps)];
+      double s = (double(o) + 0.5) * scale - 0.5;
+      if (interpolation == viennacv::NEAREST)
+      {
+        ix[0] = std::min(long(std::floor((double(o) + 0.5) * scale)), in_size - 1);
+        wt[0] = 1.0;
+      }
+      else if (interpolation == viennacv::BILINEAR || interpolation == viennacv::BICUBIC)
+      {
+        long i0 = long(std::floor(s));
+        double f = s - double(i0);
+        double w[4] = { 1.0 - f, f, 0.0, 0.0 };
+        if (interpolation == viennacv::BICUBIC)
+        {
+          cubic_weights(f, w);
+          i0 -= 1;
+        }
+        for (long k = 0; k < taps; ++k)
+        {
+          ix[k] = std::min(std::max(i0 + k, 0L), in_size - 1);
+          wt[k] = w[k];
+        }
+      }
+      else
+      {
+        // the input interval [o * scale, (o + 1) * scale) weighted by its overlap with every input pixel
+        double begin = double(o) * scale, end = std::min(double(o + 1) * scale, double(in_size));
+        long first = long(std::floor(begin));
+        for (long k = 0; k < taps; ++k)
+        {
+          long i = first + k;
+          ix[k] = std::min(i, in_size - 1);
+          double overlap = std::min(end, double(i + 1)) - std::max(begin, double(i));
+          wt[k] = (overlap > 0) ? overlap / (end - begin) : 0.0;
+        }
+      }
+    }
+  }
+};
+
+} //namespace detail
+
+//
+// Introductory note: By convention, all dimensions are already checked in the dispatcher frontend. No need to double-check again in here!
+//
+
+/** @brief Resize a channel to the size of out with nearest, bilinear, bicubic or area (box average when shrinking) interpolation, replicating the border.
+*
+* The interpolation is separable: per-column and per-row tables of source indices and weights are computed once, every input row is resampled
+* horizontally into an intermediate and the intermediate rows are combined vertically, rows distributed over threads in both passes.
+* Integer pixels use fixed-point weights with VIENNACL_WARP_FRACTION_BITS bits per pass and an integer intermediate.
+*
+* @param in             Input matrix
+* @param interpolation  NEAREST, BILINEAR, BICUBIC or AREA
+* @param out            Output matrix of the target size, must not be the same object as in
+*/
+template<typename NumericT>
+void resize(matrix_base<NumericT> const & in, viennacv::interpolation interpolation, matrix_base<NumericT> & out)
+{
+  typedef typename std::conditional<std::is_integral<NumericT>::value,
+                                    typename std::conditional<(sizeof(NumericT) <= 2), int, long long>::type,
+                                    NumericT>::type IntermediateT;
+  typedef typename std::conditional<std::is_integral<NumericT>::value, long long, NumericT>::type WeightT;
+  int const bits = std::is_integral<NumericT>::value ? 2 * VIENNACL_WARP_FRACTION_BITS : 0;
+
+  detail::channel_array<NumericT const> src = detail::extract_channel(in);
+  detail::channel_array<NumericT>       dst = detail::extract_channel(out);
+  long in_size1  = static_cast<long>(viennacl::traits::size1(in));
+  long in_size2  = static_cast<long>(viennacl::traits::size2(in));
+  long out_size1 = static_cast<long>(viennacl::traits::size1(out));
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  if (in_size1 == 0 || in_size2 == 0 || out_size1 == 0 || out_size2 == 0)
+    return;
+
+  detail::resample_table columns(in_size2, out_size2, interpolation), rows(in_size1, out_size1, interpolation);
+  std::vector<WeightT> column_weight(columns.weight.size()), row_weight(rows.weight.size());
+  for (vcl_size_t k = 0; k < columns.weight.size(); ++k)
+    column_weight[k] = std::is_integral<NumericT>::value ? WeightT(std::floor(columns.weight[k] * double(1LL << VIENNACL_WARP_FRACTION_BITS) + 0.5)) : WeightT(columns.weight[k]);
+  for (vcl_size_t k = 0; k < rows.weight.size(); ++k)
+    row_weight[k] = std::is_integral<NumericT>::value ? WeightT(std::floor(rows.weight[k] * double(1LL << VIENNACL_WARP_FRACTION_BITS) + 0.5)) : WeightT(rows.weight[k]);
+
+  // horizontal pass, every input row into the intermediate
+  std::vector<IntermediateT> intermediate(vcl_size_t(in_size1 * out_size2));
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((in_size1*out_size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < in_size1; ++row)
+  {
+    NumericT const * s = src.row(vcl_size_t(row));
+    IntermediateT  * t = &intermediate[vcl_size_t(row * out_size2)];
+    for (long col = 0; col < out_size2; ++col)
+    {
+      WeightT acc = 0;
+      for (long k = 0; k < columns.taps; ++k)
+        acc += column_weight[vcl_size_t(col * columns.taps + k)] * WeightT(s[vcl_size_t(columns.index[vcl_size_t(col * columns.taps + k)]) * src.pitches.col_pitch]);
+      t[col] = IntermediateT(acc);
+    }
+  }
+
+  // vertical pass
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((out_size1*out_size2) > VIENNACL_OPENMP_IMAGE_MIN_SIZE)
+#endif
+  for (long row = 0; row < out_size1; ++row)
+  {
+    NumericT * d = dst.row(vcl_size_t(row));
+    std::vector<WeightT> acc(vcl_size_t(out_size2), WeightT(0));
+    for (long k = 0; k < rows.taps; ++k)
+    {
+      WeightT w = row_weight[vcl_size_t(row * rows.taps + k)];
+      if (w == WeightT(0))
+        continue;
+      IntermediateT const * t = &intermediate[vcl_size_t(rows.index[vcl_size_t(row * rows.taps + k)] * out_size2)];
+      for (long col = 0; col < out_size2; ++col)
+        acc[vcl_size_t(col)] += w * WeightT(t[col]);
+    }
+    for (long col = 0; col < out_size2; ++col)
+    {
+      if constexpr (std::is_integral<NumericT>::value)
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = detail::saturate_cast<NumericT>((acc[vcl_size_t(col)] + (1LL << (bits - 1))) >> bits);
+      else
+        d[vcl_size_t(col) * dst.pitches.col_pitch] = acc[vcl_size_t(col)];
+    }
+  }
+}
+
+/** @brief Warp a channel by an affine map: out(r, c) = in(y, x) with (x, y) = (m[0] c + m[1] r + m[2], m[3] c + m[4] r + m[5]), i.e. m maps output to input positions.
+*
+* The column terms m[0] c and m[3] c are tabulated once, so every output pixel costs two additions before the interpolation. Output tiles are distributed over threads.
+*
+* @param in             Input matrix
+* @param m              Row-major 2 x 3 inverse affine map (output to input)
+* @param interpolation  NEAREST, BILINEAR or BICUBIC, AREA being sampled as BILINEAR
+* @param border         Value of the pixels outside of the input
+* @param out            Output matrix, must not be the same object as in
+*/
+template<typename NumericT>
+void warp_affine(matrix_base<NumericT> const & in, std::vector<double> const & m, viennacv::interpolation interpolation, NumericT border, matrix_base<NumericT> & out)
+{
+  long out_size2 = static_cast<long>(viennacl::traits::size2(out));
+  std::vector<double> column_x(static_cast<vcl_size_t>(out_size2)), column_y(static_cast<vcl_size_t>(out_size2));
+  for (long col = 0; col < out_size2; ++col)
+  {
+    column_x[vcl_size_t(col)] = m[0] * double(col);
+    column_y[vcl_size_t(col)] = m[3] * double(col);
+  }
+  detail::warp_dispatch(in, out, interpolation, border,
+    [&](long row, long col_begin, long col_end, double * ys, double * xs)
+    {
+      double x0 = m[1] * double(row) + m[2], y0 = m[4] * double(row) + m[5];
+      for (long col = col_begin; col < col_end; ++col)
+      {
+        xs[col - col_begin] = x0 + column_x[vcl_size_t(col)];
+        ys[col - col_begin] = y0 + column_y[vcl_size_t(col)];
+      }
+    });
+}
+
+/** @brief Warp a channel by a perspective map: out(r, c) = in(y, x) with (x, y) = ((m[0] c + m[1] r + m[2]) / w, (m[3] c + m[4] r + m[5]) / w), w = m[6] c + m[7] r + m[8], i.e. m maps output to input positions. Output positions with w = 0 read the border.
+*
+* @param in             Input matrix
+* @param m              Row-major 3 x 3 inverse homography (output to input)
+* @param interpolation  NEAREST, BILINEAR or BICUBIC, AREA being sampled as BILINEAR
+* @param border         Value of the pixels outside of the input
+* @param out            Output matrix, must not be the same object as in
+*/
+template<typename NumericT>
+void warp_perspective(matrix_base<NumericT> const & in, std::vector<double> const & m, viennacv::interpolation interpolation, NumericT border, matrix_base<NumericT> & out)
+{
+  detail::warp_dispatch(in, out, interpolation, border,
+    [&](long row, long col_begin, long col_end, double * ys, double * xs)
+    {
+      double x0 = m[1] * double(row) + m[2], y0 = m[4] * double(row) + m[5], w0 = m[7] * double(row) + m[8];
+      for (long col = col_begin; col < col_end; ++col)
+      {
+        double w = w0 + m[6] * double(col);
+        double inv = (w != 0) ? 1.0 / w : 0.0;
+        xs[col - col_begin] = (w != 0) ? (x0 + m[0] * double(col)) * inv : -1e9;
+        ys[col - col_begin] = (w != 0) ? (y0 + m[3] * double(col)) * inv : -1e9;
+      }
+    });
+}
+
+/** @brief Remap a channel by precomputed maps: out(r, c) = in(map_y(r, c), map_x(r, c)), e.g. a lens undistortion map computed once and applied to every frame.
+*
+* @param in             Input matrix
+* @param map_x          Source column of every output pixel
+* @param map_y          Source row of every output pixel
+* @param interpolation  NEAREST, BILINEAR or BICUBIC, AREA being sampled as BILINEAR
+* @param border         Value of the pixels outside of the input
+* @param out            Output matrix of the size of the maps, must not be the same object as in
+*/
+template<typename NumericT, typename MapT>
+void remap(matrix_base<NumericT> const & in, matrix_base<MapT> const & map_x, matrix_base<MapT> const & map_y, viennacv::interpolation interpolation, NumericT border, matrix_base<NumericT> & out)
+{
+  detail::channel_array<MapT const> mx = detail::extract_channel(map_x);
+  detail::channel_array<MapT const> my = detail::extract_channel(map_y);
+  detail::warp_dispatch(in, out, interpolation, border,
+    [&](long row, long col_begin, long col_end, double * ys, double * xs)
+    {
+      MapT const * px = mx.row(vcl_size_t(row));
+      MapT const * py = my.row(vcl_size_t(row));
+      for (long col = col_begin; col < col_end; ++col)
+      {
+        xs[col - col_begin] = double(px[vcl_size_t(col) * mx.pitches.col_pitch]);
+        ys[col - col_begin] = double(py[vcl_size_t(col) * my.pitches.col_pitch]);
+      }
+    });
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
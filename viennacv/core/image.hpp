@@ -20,9 +20,25 @@
     @brief Implementation of the image matrix class in ViennaCV library
 */
 
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
 #include "viennacl/forwards.h"
 // #include "viennacl/detail/matrix_def.hpp"
 #include "viennacl/scalar.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/fft.hpp"
+#include "viennacl/linalg/host_based/convolution_operations.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacl/linalg/host_based/fft_operations.hpp"
 #include "viennacv/core/image_enum.hpp"
 // #include "viennacl/linalg/matrix_operations.hpp"
 // #include "viennacl/linalg/sparse_matrix_operations.hpp"
@@ -38,12 +54,106 @@
 
 
 
+// Maximum number of fraction bits of the fixed-point taps used to convolve integer pixels:
+#ifndef VIENNACV_FIXED_POINT_FRACTION_BITS
+  #define VIENNACV_FIXED_POINT_FRACTION_BITS  14
+#endif
+
 // SECTION 01a Predeclare the image class
 namespace viennacv
 {
 template <typename NumericT>
 class image_colpre;
 
+template <typename NumericT>
+class image_view;
+
+/** @brief Rectangle of an image: rows x columns pixels starting at pixel (top, left) */
+struct image_rect
+{
+    size_t top      = 0;
+    size_t left     = 0;
+    size_t rows     = 0;
+    size_t columns  = 0;
+};
+
+/** @brief A host buffer of pixels owned by the caller, e.g. a captured frame: sample (c, i, j) is data[c * channel_stride + i * row_stride + j * column_stride],
+ *  the strides being counted in samples. See hwc_buffer and chw_buffer for the usual layouts, and viennacl::copy to move pixels in and out of images.
+ * @tparam SampleT : Sample type, const for a buffer that is only read
+ */
+template <typename SampleT>
+struct image_buffer
+{
+    SampleT * data          = nullptr;
+    size_t color_num        = 0;
+    size_t row_num          = 0;
+    size_t column_num       = 0;
+    long channel_stride     = 0;
+    long row_stride         = 0;
+    long column_stride      = 0;
+};
+
+/** @brief Interleaved (HWC) buffer, e.g. RGBRGB...
+ * @param  {SampleT *} data          : Sample of channel 0 at pixel (0, 0)
+ * @param  {size_t} l_row_num        : 
+ * @param  {size_t} l_column_num     : 
+ * @param  {size_t} l_color_num      : 
+ * @param  {size_t} l_row_stride     : Samples from one row to the next, 0 for l_column_num * l_color_num (no row padding)
+ * @return {image_buffer<SampleT>}   : 
+ */
+template <typename SampleT>
+image_buffer<SampleT> hwc_buffer(SampleT * data, size_t l_row_num, size_t l_column_num, size_t l_color_num, size_t l_row_stride = 0)
+{
+    image_buffer<SampleT> t_buffer;
+    t_buffer.data = data;
+    t_buffer.color_num = l_color_num;
+    t_buffer.row_num = l_row_num;
+    t_buffer.column_num = l_column_num;
+    t_buffer.channel_stride = 1;
+    t_buffer.row_stride = (long)((l_row_stride != 0) ? l_row_stride : l_column_num * l_color_num);
+    t_buffer.column_stride = (long)l_color_num;
+    return t_buffer;
+}
+
+/** @brief Planar (CHW) buffer, one channel after the other
+ * @param  {SampleT *} data          : Sample of channel 0 at pixel (0, 0)
+ * @param  {size_t} l_color_num      : 
+ * @param  {size_t} l_row_num        : 
+ * @param  {size_t} l_column_num     : 
+ * @param  {size_t} l_row_stride     : Samples from one row to the next, 0 for l_column_num (no row padding)
+ * @param  {size_t} l_channel_stride : Samples from one channel to the next, 0 for l_row_num rows
+ * @return {image_buffer<SampleT>}   : 
+ */
+template <typename SampleT>
+image_buffer<SampleT> chw_buffer(SampleT * data, size_t l_color_num, size_t l_row_num, size_t l_column_num, size_t l_row_stride = 0, size_t l_channel_stride = 0)
+{
+    image_buffer<SampleT> t_buffer;
+    t_buffer.data = data;
+    t_buffer.color_num = l_color_num;
+    t_buffer.row_num = l_row_num;
+    t_buffer.column_num = l_column_num;
+    t_buffer.column_stride = 1;
+    t_buffer.row_stride = (long)((l_row_stride != 0) ? l_row_stride : l_column_num);
+    t_buffer.channel_stride = (long)((l_channel_stride != 0) ? l_channel_stride : l_row_num * (size_t)t_buffer.row_stride);
+    return t_buffer;
+}
+
+/** @brief Types used inside the kernels for a pixel type. Floating point pixels use themselves everywhere. Integer pixels (e.g. uint8_t, uint16_t) are stored narrow, 
+ * take float kernel taps which are quantized to fixed point, and are widened to accumulator_type only inside the kernels before the result is saturated back. */
+template <typename NumericT, bool IsIntegral = std::is_integral<NumericT>::value>
+struct pixel_traits
+{
+    typedef NumericT tap_type;
+    typedef NumericT accumulator_type;
+};
+
+template <typename NumericT>
+struct pixel_traits<NumericT, true>
+{
+    typedef float tap_type;
+    typedef typename std::conditional<(sizeof(NumericT) < 2), int32_t, int64_t>::type accumulator_type;
+};
+
 } //namespace viennacv
 
 
@@ -86,6 +196,101 @@ void copy(  const viennacv::image_colpre<NumericT> & i_image_colpre,
     for (size_t color = 0; color < i_image_colpre.get_color_num(); color++)
         viennacl::copy(i_image_colpre.data_[color], o_std_image->at(color));
 }
+
+// SECTION 02_003 COPY interface with strided host buffers
+/** @brief Conversion: strided host buffer -> image_colpre, in a single pass over the buffer with rows distributed over threads
+ * 
+ * Samples are converted to the pixel type on the fly, rounded and saturated for integer pixels. Channels in host memory are written directly; channels in
+ * other memory are filled in a host staging buffer of their padded size first and transferred at once.
+ * 
+ * @param  {viennacv::image_buffer<SampleT>} i_buffer        : Source pixels, e.g. viennacv::hwc_buffer(frame, 1080, 1920, 3)
+ * @param  {viennacv::image_colpre<NumericT>} o_image_colpre : Output image, resized to the buffer size if necessary
+ * @param  {double} scale                                    : Factor applied to every sample, e.g. 1.0 / 255 to read 8-bit samples into float pixels in [0, 1]
+ */
+template <typename SampleT, typename NumericT>
+void copy(  const viennacv::image_buffer<SampleT> & i_buffer, 
+            viennacv::image_colpre<NumericT> *o_image_colpre,
+            double scale = 1.0)
+{
+    typedef typename std::remove_const<SampleT>::type sample_type;
+    o_image_colpre->data_.resize(i_buffer.color_num);
+    if ((i_buffer.color_num == 0) || (i_buffer.row_num == 0) || (i_buffer.column_num == 0))
+        return;
+
+    // NOTE The staging matrices are reserved up front, a reallocation would deep-copy them and invalidate the channel pointers.
+    std::vector<std::vector<NumericT>>              t_staging(i_buffer.color_num);
+    std::vector<viennacl::matrix_base<NumericT>>    t_wrapped;
+    std::vector<viennacl::matrix_base<NumericT> *>  t_channels;
+    t_wrapped.reserve(i_buffer.color_num);
+    for (size_t color = 0; color < i_buffer.color_num; color++)
+    {
+        viennacl::matrix<NumericT> & t_channel = o_image_colpre->data_[color];
+        if ((t_channel.size1() != i_buffer.row_num) || (t_channel.size2() != i_buffer.column_num))
+            t_channel.resize(i_buffer.row_num, i_buffer.column_num, false);
+        if (viennacl::traits::active_handle_id(t_channel) == viennacl::MAIN_MEMORY)
+        {
+            t_channels.push_back(&t_channel);
+            continue;
+        }
+        t_staging[color].resize(t_channel.internal_size());
+        t_wrapped.emplace_back(t_staging[color].data(), viennacl::MAIN_MEMORY, t_channel.size1(), 0, 1, t_channel.internal_size1(), 
+                                                                               t_channel.size2(), 0, 1, t_channel.internal_size2(), true);
+        t_channels.push_back(&t_wrapped.back());
+    }
+
+    viennacl::linalg::host_based::import_samples<sample_type>(
+        reinterpret_cast<const unsigned char *>(i_buffer.data), i_buffer.channel_stride * (long)sizeof(SampleT), 
+        i_buffer.row_stride * (long)sizeof(SampleT), i_buffer.column_stride * (long)sizeof(SampleT), scale, false, t_channels);
+
+    for (size_t color = 0; color < i_buffer.color_num; color++)
+        if (!t_staging[color].empty())
+            viennacl::backend::memory_write(o_image_colpre->data_[color].handle(), 0, sizeof(NumericT) * t_staging[color].size(), t_staging[color].data());
+}
+
+/** @brief Conversion: image_colpre -> strided host buffer, in a single pass over the buffer with rows distributed over threads
+ * 
+ * Pixels are converted to the sample type on the fly, rounded and saturated for integer samples. Channels in other memory than the host are read back
+ * at once into a staging buffer first.
+ * 
+ * @param  {viennacv::image_colpre<NumericT>} i_image_colpre : Input image
+ * @param  {viennacv::image_buffer<SampleT>} o_buffer        : Destination pixels of the image size, e.g. viennacv::chw_buffer(tensor, 3, 224, 224)
+ * @param  {double} scale                                    : Factor applied to every pixel, e.g. 255 to write float pixels in [0, 1] as 8-bit samples
+ */
+template <typename NumericT, typename SampleT>
+void copy(  const viennacv::image_colpre<NumericT> & i_image_colpre, 
+            const viennacv::image_buffer<SampleT> & o_buffer,
+            double scale = 1.0)
+{
+    static_assert(!std::is_const<SampleT>::value, "viennacl::copy(): the destination buffer must not be const");
+    assert( (o_buffer.color_num == i_image_colpre.get_color_num()) 
+            && ((o_buffer.color_num == 0) || ((o_buffer.row_num == i_image_colpre.get_row_num()) && (o_buffer.column_num == i_image_colpre.get_column_num())))
+            && bool("Check failed in copy(): the buffer does not have the image size!") );
+    if ((o_buffer.color_num == 0) || (o_buffer.row_num == 0) || (o_buffer.column_num == 0))
+        return;
+
+    std::vector<std::vector<NumericT>>                  t_staging(o_buffer.color_num);
+    std::vector<viennacl::matrix_base<NumericT>>        t_wrapped;
+    std::vector<viennacl::matrix_base<NumericT> const *> t_channels;
+    t_wrapped.reserve(o_buffer.color_num);
+    for (size_t color = 0; color < o_buffer.color_num; color++)
+    {
+        const viennacl::matrix<NumericT> & t_channel = i_image_colpre.data_[color];
+        if (viennacl::traits::active_handle_id(t_channel) == viennacl::MAIN_MEMORY)
+        {
+            t_channels.push_back(&t_channel);
+            continue;
+        }
+        t_staging[color].resize(t_channel.internal_size());
+        viennacl::backend::memory_read(t_channel.handle(), 0, sizeof(NumericT) * t_staging[color].size(), t_staging[color].data());
+        t_wrapped.emplace_back(t_staging[color].data(), viennacl::MAIN_MEMORY, t_channel.size1(), 0, 1, t_channel.internal_size1(), 
+                                                                               t_channel.size2(), 0, 1, t_channel.internal_size2(), true);
+        t_channels.push_back(&t_wrapped.back());
+    }
+
+    viennacl::linalg::host_based::export_samples<SampleT>(
+        t_channels, reinterpret_cast<unsigned char *>(o_buffer.data), o_buffer.channel_stride * (long)sizeof(SampleT), 
+        o_buffer.row_stride * (long)sizeof(SampleT), o_buffer.column_stride * (long)sizeof(SampleT), scale, false);
+}
 } // namespace viennacl
 
 
@@ -100,7 +305,7 @@ class image_colpre
 {
 public:
     std::vector<viennacl::matrix<NumericT>> data_;    /** @brief The image data_ organized by a STL vector */
-    image_format image_format_;
+    image_format image_format_ = RGB;
 public:
     inline size_t get_color_num()  const { return data_.size();};
     inline size_t get_row_num()    const { return data_[0].size1();};
@@ -119,8 +324,30 @@ public:
      */
     explicit image_colpre(const std::vector<std::vector<std::vector<NumericT>>> & i_std_image);
     explicit image_colpre(const image_colpre<NumericT> & i_image);
-    // TODO: Move assignment not yet implemented. 
-    // image_colpre(image_colpre<NumericT> && i_image);
+    /** @brief Move constructor, takes over the channels of i_image without copying. i_image is left with no channel. */
+    image_colpre(image_colpre<NumericT> && i_image) noexcept;
+    /** @brief image_colpre constructor adopting existing channels without copying
+     * @param  {std::vector<viennacl::matrix<NumericT>>} i_channels : Channels of the same size, moved into the image
+     * @param  {image_format} l_image_format                         : Format of the channels
+     */
+    explicit image_colpre(std::vector<viennacl::matrix<NumericT>> && i_channels, image_format l_image_format = image_format::RGB);
+    /** @brief image_colpre constructor wrapping a planar host buffer without copying. The buffer stays owned by the caller and must outlive the image and every move of it.
+     * @param  {NumericT *} i_host_buffer : l_color_num consecutive channels of l_row_num x l_column_num row-major pixels
+     * @param  {size_t} l_color_num       : 
+     * @param  {size_t} l_row_num         : 
+     * @param  {size_t} l_column_num      : 
+     */
+    explicit image_colpre(NumericT * i_host_buffer, size_t l_color_num, size_t l_row_num, size_t l_column_num);
+
+    image_colpre<NumericT> & operator=(const image_colpre<NumericT> & i_image);
+    image_colpre<NumericT> & operator=(image_colpre<NumericT> && i_image) noexcept;
+    /** @brief Exchange the channels and format with another image, no pixel is copied */
+    void swap(image_colpre<NumericT> & io_image) noexcept;
+    /** @brief Exchange the memory of one channel with a matrix of the same size, e.g. to take over the result of a matrix operation. No pixel is copied. 
+     * @param  {size_t} color                          : Channel index
+     * @param  {viennacl::matrix<NumericT>} io_matrix  : Matrix of the channel size, receives the previous channel memory
+     */
+    void swap_channel(size_t color, viennacl::matrix<NumericT> & io_matrix);
     /** @brief ~image Destructor*/
     // ~image_colpre();
 
@@ -137,6 +364,7 @@ public:
 // SECTION 01_001a Null Constructor
 template <typename NumericT>
 image_colpre<NumericT>::image_colpre(size_t l_color_num, ssize_t l_row_num, ssize_t l_column_num)
+    : image_format_(l_color_num == 1 ? Gray : RGB)
 {
     this->data_.resize(l_color_num);
     for (size_t color = 0; color < l_color_num; color++)
@@ -146,6 +374,7 @@ image_colpre<NumericT>::image_colpre(size_t l_color_num, ssize_t l_row_num, ssiz
 // SECTION 01_001b Constructor <- std::vector<std::vector<std::vector<NumericT>>>
 template <typename NumericT>
 image_colpre<NumericT>::image_colpre(const std::vector<std::vector<std::vector<NumericT>>> & i_std_image)
+    : image_format_(i_std_image.size() == 1 ? Gray : RGB)
 {
     this->data_.resize(i_std_image.size());
     for (size_t color = 0; color < i_std_image.size(); color++)
@@ -156,15 +385,87 @@ image_colpre<NumericT>::image_colpre(const std::vector<std::vector<std::vector<N
 }
 
 // SECTION 01_001c Copy Constructor <- viennacv::image_colpre
+// NOTE Every channel is copy-constructed once, instead of being allocated by resize and then assigned.
 template <typename NumericT>
 image_colpre<NumericT>::image_colpre(const image_colpre<NumericT> & i_image)
+    : data_(i_image.data_), image_format_(i_image.image_format_)
+{
+}
+
+// SECTION 01_001d Move Constructor <- viennacv::image_colpre
+// NOTE viennacl::matrix has no move constructor, moving the std::vector hands over the channel objects themselves.
+template <typename NumericT>
+image_colpre<NumericT>::image_colpre(image_colpre<NumericT> && i_image) noexcept
+    : data_(std::move(i_image.data_)), image_format_(i_image.image_format_)
+{
+    i_image.data_.clear();
+}
+
+// SECTION 01_001e Constructor <- std::vector<viennacl::matrix<NumericT>>
+template <typename NumericT>
+image_colpre<NumericT>::image_colpre(std::vector<viennacl::matrix<NumericT>> && i_channels, image_format l_image_format)
+    : data_(std::move(i_channels)), image_format_(l_image_format)
+{
+    i_channels.clear();
+}
+
+// SECTION 01_001f Constructor <- planar host buffer
+template <typename NumericT>
+image_colpre<NumericT>::image_colpre(NumericT * i_host_buffer, size_t l_color_num, size_t l_row_num, size_t l_column_num)
+    : image_format_(l_color_num == 1 ? Gray : RGB)
+{
+    // NOTE Channels are constructed in place, a reallocation of data_ would deep-copy the wrapped matrices.
+    this->data_.reserve(l_color_num);
+    for (size_t color = 0; color < l_color_num; color++)
+        this->data_.emplace_back(i_host_buffer + color * l_row_num * l_column_num, viennacl::MAIN_MEMORY, l_row_num, l_column_num);
+}
+
+// SECTION 01_001g Assignment & swap
+template <typename NumericT>
+image_colpre<NumericT> & image_colpre<NumericT>::operator=(const image_colpre<NumericT> & i_image)
 {
-    this->data_.resize(i_image.get_color_num());
+    if (this == &i_image) return *this;
+    // NOTE Channels of the same size keep their memory, others are reallocated.
+    if (this->data_.size() != i_image.data_.size())
+        this->data_.resize(i_image.data_.size());
     for (size_t color = 0; color < i_image.get_color_num(); color++)
     {
-        this->data_[color].resize(i_image.get_row_num(), i_image.get_column_num());
+        if ((this->data_[color].size1() != i_image.data_[color].size1()) || (this->data_[color].size2() != i_image.data_[color].size2()))
+            this->data_[color].resize(i_image.data_[color].size1(), i_image.data_[color].size2(), false);
         this->data_[color] = i_image.data_[color];
     }
+    this->image_format_ = i_image.image_format_;
+    return *this;
+}
+
+template <typename NumericT>
+image_colpre<NumericT> & image_colpre<NumericT>::operator=(image_colpre<NumericT> && i_image) noexcept
+{
+    this->swap(i_image);
+    return *this;
+}
+
+template <typename NumericT>
+void image_colpre<NumericT>::swap(image_colpre<NumericT> & io_image) noexcept
+{
+    this->data_.swap(io_image.data_);
+    std::swap(this->image_format_, io_image.image_format_);
+}
+
+template <typename NumericT>
+void image_colpre<NumericT>::swap_channel(size_t color, viennacl::matrix<NumericT> & io_matrix)
+{
+    viennacl::matrix<NumericT> & t_channel = this->data_[color];
+    assert( (t_channel.size1() == io_matrix.size1()) && (t_channel.size2() == io_matrix.size2())
+            && (t_channel.internal_size1() == io_matrix.internal_size1()) && (t_channel.internal_size2() == io_matrix.internal_size2())
+            && bool("Check failed in image_colpre::swap_channel(): the matrix does not have the channel size!") );
+    t_channel.handle().swap(io_matrix.handle());
+}
+
+template <typename NumericT>
+inline void swap(image_colpre<NumericT> & io_image1, image_colpre<NumericT> & io_image2) noexcept
+{
+    io_image1.swap(io_image2);
 }
 
 
@@ -175,12 +476,547 @@ image_colpre<NumericT>::image_colpre(const image_colpre<NumericT> & i_image)
 // }
 
 
+// SECTION 03_001 Separable Image Convolution
+namespace detail
+{
+/** @brief Number of fixed-point fraction bits for a set of taps such that max_pixel * sum|w| * 2^bits still fits the accumulator. Integer-valued taps need none. */
+template <typename NumericT, typename AccumT>
+unsigned int fixed_point_fraction_bits(const std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> & i_taps)
+{
+    double l_sum = 0;
+    bool l_integral = true;
+    for (auto & tap: i_taps)
+    {
+        l_sum += std::abs(tap.weight);
+        l_integral = l_integral && (tap.weight == std::floor(tap.weight));
+    }
+    if (l_integral) return 0;
+    double l_headroom = (double)std::numeric_limits<AccumT>::max() / ((double)std::numeric_limits<NumericT>::max() * std::max(l_sum, 1.0));
+    unsigned int l_bits = 0;
+    while (l_bits < VIENNACV_FIXED_POINT_FRACTION_BITS && std::ldexp(1.0, l_bits + 1) <= l_headroom) l_bits++;
+    return l_bits;
+}
+
+/** @brief Taps in the form the host engine consumes: the pixel type for floating point pixels, fixed point in the accumulator type for integer pixels. InNumericT is the type of the pass input, which is the accumulator itself for the second pass of a separable integer convolution. */
+template <typename NumericT, typename InNumericT = NumericT>
+struct host_taps
+{
+    typedef typename std::conditional<std::is_integral<NumericT>::value, 
+                typename std::conditional<std::is_same<InNumericT, NumericT>::value, 
+                                          typename pixel_traits<NumericT>::accumulator_type, int64_t>::type, 
+                NumericT>::type weight_type;
+
+    std::vector<viennacl::linalg::host_based::detail::convolution_tap<weight_type>> taps;
+    unsigned int bits = 0;  // Fixed-point fraction bits of the weights
+};
+
+/** @brief Convert taps to host_taps, quantizing the weights to fixed point for integer pixels. */
+template <typename NumericT, typename InNumericT = NumericT>
+host_taps<NumericT, InNumericT> make_host_taps(const std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> & i_taps)
+{
+    typedef typename host_taps<NumericT, InNumericT>::weight_type WeightT;
+    host_taps<NumericT, InNumericT> t_taps;
+    if constexpr (std::is_integral<NumericT>::value)
+        t_taps.bits = fixed_point_fraction_bits<NumericT, WeightT>(i_taps);
+    for (auto & tap: i_taps)
+    {
+        if constexpr (std::is_integral<NumericT>::value)
+            t_taps.taps.push_back({tap.row_bias, tap.col_bias, (WeightT)std::llround(std::ldexp(tap.weight, t_taps.bits))});
+        else
+            t_taps.taps.push_back({tap.row_bias, tap.col_bias, (WeightT)tap.weight});
+    }
+    return t_taps;
+}
+
+/** @brief Run the host convolution engine on prepared taps. Integer pixels saturate to the output type, see convolve_host.
+ * 
+ * @param  {viennacl::matrix_base<InNumericT>} i_matrix    : Input matrix on host memory, must not alias o_matrix
+ * @param  {host_taps<NumericT, InNumericT>} i_taps        : Taps from make_host_taps
+ * @param  {viennacl::matrix_base<OutNumericT>} o_matrix   : Output matrix of the same size
+ * @param  {unsigned int} extra_shift                      : Fraction bits carried by the input (two-pass fixed point)
+ * @param  {size_t} row_begin                              : First output row to compute
+ * @param  {size_t} row_end                                : Output row after the last one to compute
+ * @param  {convolution_geometry} geometry                 : Output window and border mode, see make_geometry
+ * @return {unsigned int}                                  : Fraction bits left in the output, non-zero only if OutNumericT is the accumulator itself
+ */
+template <typename NumericT, typename InNumericT, typename OutNumericT>
+unsigned int run_host_taps(
+    const viennacl::matrix_base<InNumericT> & i_matrix,
+    const host_taps<NumericT, InNumericT> & i_taps,
+    viennacl::matrix_base<OutNumericT> & o_matrix,
+    unsigned int extra_shift = 0,
+    size_t row_begin = 0,
+    size_t row_end = size_t(-1),
+    viennacl::linalg::host_based::detail::convolution_geometry geometry = viennacl::linalg::host_based::detail::convolution_geometry())
+{
+    if constexpr (std::is_integral<NumericT>::value)
+    {
+        // NOTE Pixels of the pixel type are rounded back, the accumulator type keeps its fraction bits for the next pass. The constant border is
+        //      given in pixel units and scaled to the fraction bits the input carries.
+        bool l_keep = std::is_same<OutNumericT, typename pixel_traits<NumericT>::accumulator_type>::value && !std::is_same<OutNumericT, NumericT>::value;
+        geometry.border_value = std::ldexp(geometry.border_value, (int)extra_shift);
+        viennacl::linalg::host_based::convolve_fixed_point(i_matrix, i_taps.taps, o_matrix, l_keep ? 0 : i_taps.bits + extra_shift, row_begin, row_end, geometry);
+        return l_keep ? i_taps.bits : 0;
+    }
+    else
+    {
+        viennacl::linalg::host_based::convolve(i_matrix, i_taps.taps, o_matrix, row_begin, row_end, geometry);
+        return 0;
+    }
+}
+
+/** @brief Run the host convolution engine on a list of taps. Floating point pixels accumulate in their own type. Integer pixels accumulate in pixel_traits::accumulator_type with the taps quantized to fixed point, plus 'extra_shift' bits already present in the input, and saturate to the output type.
+ * 
+ * @param  {viennacl::matrix_base<InNumericT>} i_matrix : Input matrix on host memory, must not alias o_matrix
+ * @param  {std::vector<convolution_tap<double>>} i_taps : Taps with offsets relative to the output pixel
+ * @param  {viennacl::matrix_base<OutNumericT>} o_matrix : Output matrix of the same size
+ * @param  {unsigned int} extra_shift                    : Fraction bits carried by the input (two-pass fixed point)
+ * @return {unsigned int}                                : Fraction bits left in the output, non-zero only if OutNumericT is the accumulator itself
+ */
+template <typename NumericT, typename InNumericT, typename OutNumericT>
+unsigned int convolve_host(
+    const viennacl::matrix_base<InNumericT> & i_matrix,
+    const std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> & i_taps,
+    viennacl::matrix_base<OutNumericT> & o_matrix,
+    unsigned int extra_shift = 0,
+    const viennacl::linalg::host_based::detail::convolution_geometry & geometry = viennacl::linalg::host_based::detail::convolution_geometry())
+{
+    return run_host_taps<NumericT>(i_matrix, make_host_taps<NumericT, InNumericT>(i_taps), o_matrix, extra_shift, 0, size_t(-1), geometry);
+}
+
+/** @brief Output length of a convolution along one axis: the input length for EQUIV, the positions where the kernel lies inside of the input for INNER,
+ *  and every position where it touches the input for OUTER. */
+inline size_t convolution_output_size(ConvolutionType type, size_t l_size, size_t l_kernel_size)
+{
+    if (type == ConvolutionType::INNER)
+        return (l_size + 1 > l_kernel_size) ? l_size + 1 - l_kernel_size : 0;
+    if (type == ConvolutionType::OUTER)
+        return l_size + l_kernel_size - 1;
+    return l_size;
+}
+
+/** @brief Host engine geometry of a kernel of l_kernel_size1 x l_kernel_size2 with its origin at the center entry (size - 1) / 2: the output window of
+ *  the convolution type and the border mode of the input. */
+inline viennacl::linalg::host_based::detail::convolution_geometry make_geometry(
+    ConvolutionType type, size_t l_kernel_size1, size_t l_kernel_size2, border_mode border, double border_value)
+{
+    viennacl::linalg::host_based::detail::convolution_geometry t_geometry;
+    long l_half1 = ((long)l_kernel_size1 - 1) / 2, 
+         l_half2 = ((long)l_kernel_size2 - 1) / 2;
+    if (type == ConvolutionType::INNER)
+    {
+        t_geometry.row_offset = l_half1;
+        t_geometry.col_offset = l_half2;
+    }
+    else if (type == ConvolutionType::OUTER)
+    {
+        t_geometry.row_offset = l_half1 - ((long)l_kernel_size1 - 1);
+        t_geometry.col_offset = l_half2 - ((long)l_kernel_size2 - 1);
+    }
+    t_geometry.border       = (int)border;
+    t_geometry.border_value = border_value;
+    return t_geometry;
+}
+
+/** @brief Host tap list of a 1-D kernel along the rows (Direction::X) or along the columns (Direction::Y), zero taps dropped */
+template <Direction Direct, typename TapT>
+std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> make_1d_taps(const std::vector<TapT> & i_taps)
+{
+    long l_half = ((long)i_taps.size() - 1) / 2;
+    std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> t_taps;
+    for (long tap = 0; tap < (long)i_taps.size(); tap++)
+        if (i_taps[tap] != TapT(0))
+            t_taps.push_back({(Direct == Direction::Y) ? tap - l_half : 0, 
+                              (Direct == Direction::X) ? tap - l_half : 0, (double)i_taps[tap]});
+    return t_taps;
+}
+
+/** @brief Host tap list of a 2D kernel restricted to the ROI entries (all entries if empty), zero taps dropped. The origin is the center entry. */
+template <typename NumericT>
+std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> make_kernel_taps(
+    const viennacl::matrix<NumericT> & i_kernel,
+    const std::vector<std::pair<size_t, size_t>> & ROIrc_vec)
+{
+    long l_half1 = ((long)i_kernel.size1() - 1) / 2, 
+         l_half2 = ((long)i_kernel.size2() - 1) / 2;
+    std::vector< std::vector<NumericT> > t_kernel(i_kernel.size1(), std::vector<NumericT>(i_kernel.size2()));
+    viennacl::copy(i_kernel, t_kernel);
+    std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> t_taps;
+    if (ROIrc_vec.empty())
+    {
+        for (size_t i = 0; i < i_kernel.size1(); i++)
+        for (size_t j = 0; j < i_kernel.size2(); j++)
+            if (t_kernel[i][j] != NumericT(0))
+                t_taps.push_back({(long)i - l_half1, (long)j - l_half2, (double)t_kernel[i][j]});
+    }
+    for (auto & iter: ROIrc_vec)
+        if (t_kernel[iter.first][iter.second] != NumericT(0))
+            t_taps.push_back({(long)iter.first - l_half1, (long)iter.second - l_half2, (double)t_kernel[iter.first][iter.second]});
+    return t_taps;
+}
+
+/** @brief One 1-D convolution pass along the rows (Direction::X, taps walk the columns) or along the columns (Direction::Y, taps walk the rows)
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix, must not alias o_matrix
+ * @param  {std::vector<TapT>} i_taps            : 1-D kernel taps, the origin is the center tap (size-1)/2
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix with the same size as i_matrix
+ */
+template <Direction Direct, typename NumericT, typename TapT>
+void convolve_1d_pass(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const std::vector<TapT> & i_taps,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    int l_half = ((int)i_taps.size() - 1) / 2;
+    int l_len = (Direct == Direction::X) ? (int)i_matrix.size2() : (int)i_matrix.size1();
+
+    // NOTE Host memory goes to the cache-blocked engine, other backends fall back to one matrix_range axpy per tap.
+    if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+    {
+        viennacv::detail::convolve_host<NumericT>(i_matrix, make_1d_taps<Direct>(i_taps), o_matrix);
+        return;
+    }
+    if constexpr (std::is_integral<NumericT>::value)
+        throw viennacl::memory_exception("not implemented");
+    else
+    {
+
+    viennacl::range l_all(0, (Direct == Direction::X) ? i_matrix.size1() : i_matrix.size2());
+
+    o_matrix.clear();
+    for (int tap = 0; tap < (int)i_taps.size(); tap++)
+    {
+        int bias = tap - l_half;
+        if (i_taps[tap] == NumericT(0) || std::abs(bias) >= l_len) continue;
+        viennacl::range range_from(std::max(bias, 0), l_len + std::min(bias, 0)),
+                        range_to(std::max(-bias, 0), l_len + std::min(-bias, 0));
+        if constexpr (Direct == Direction::X)
+        {
+            viennacl::matrix_range<viennacl::matrix<NumericT>>  
+                submatrix_to_add(i_matrix, l_all, range_from),
+                submatrix_tobe_add(o_matrix, l_all, range_to);
+            submatrix_tobe_add += i_taps[tap] * submatrix_to_add;
+        }
+        else
+        {
+            viennacl::matrix_range<viennacl::matrix<NumericT>>  
+                submatrix_to_add(i_matrix, range_from, l_all),
+                submatrix_tobe_add(o_matrix, range_to, l_all);
+            submatrix_tobe_add += i_taps[tap] * submatrix_to_add;
+        }
+    }
+    }
+}
+} //namespace viennacv::detail
+
+// SECTION 03_001a Rank-1 kernel detection
+/** @brief Split a 2D kernel into a column kernel and a row kernel such that kernel(r, c) = column_kernel[r] * row_kernel[c]. The dominant singular triplet is computed by power iteration on the host since kernels are tiny, and the split is accepted if the rank-1 residual is negligible.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_kernel       : 2D kernel to be split
+ * @param  {std::vector<NumericT>} o_column_kernel     : Output taps along the rows, size i_kernel.size1()
+ * @param  {std::vector<NumericT>} o_row_kernel        : Output taps along the columns, size i_kernel.size2()
+ * @param  {NumericT} tolerance                        : Accepted relative Frobenius residual ||K - s u v^T|| / ||K||
+ * @return {bool}                                      : true if the kernel is separable, then the output taps are valid
+ */
+template <typename NumericT>
+bool separate_kernel(
+    const viennacl::matrix<NumericT> & i_kernel,
+    std::vector<NumericT> & o_column_kernel,
+    std::vector<NumericT> & o_row_kernel,
+    NumericT tolerance = NumericT(1e-5))
+{
+    size_t  l_size1 = i_kernel.size1(), 
+            l_size2 = i_kernel.size2();
+    std::vector< std::vector<NumericT> > t_kernel(l_size1, std::vector<NumericT>(l_size2));
+    viennacl::copy(i_kernel, t_kernel);
+
+    // NOTE Start the power iteration from the column of largest norm, which is never orthogonal to the dominant right singular vector of a non-zero kernel.
+    double l_norm2 = 0, l_max_colnorm2 = 0;
+    size_t l_max_col = 0;
+    for (size_t j = 0; j < l_size2; j++)
+    {
+        double l_colnorm2 = 0;
+        for (size_t i = 0; i < l_size1; i++)
+            l_colnorm2 += (double)t_kernel[i][j] * t_kernel[i][j];
+        l_norm2 += l_colnorm2;
+        if (l_colnorm2 > l_max_colnorm2) { l_max_colnorm2 = l_colnorm2; l_max_col = j; }
+    }
+    if (l_norm2 == 0) return false;
+
+    std::vector<double> u(l_size1), v(l_size2, 0.0);
+    v[l_max_col] = 1.0;
+    double sigma = 0;
+    for (size_t iter = 0; iter < 64; iter++)
+    {
+        // u = K v / |K v|, v = K^T u / |K^T u|
+        double l_unorm = 0, l_vnorm = 0;
+        for (size_t i = 0; i < l_size1; i++)
+        {
+            u[i] = 0;
+            for (size_t j = 0; j < l_size2; j++) u[i] += t_kernel[i][j] * v[j];
+            l_unorm += u[i] * u[i];
+        }
+        l_unorm = std::sqrt(l_unorm);
+        for (size_t i = 0; i < l_size1; i++) u[i] /= l_unorm;
+        std::vector<double> v_prev(v);
+        for (size_t j = 0; j < l_size2; j++)
+        {
+            v[j] = 0;
+            for (size_t i = 0; i < l_size1; i++) v[j] += t_kernel[i][j] * u[i];
+            l_vnorm += v[j] * v[j];
+        }
+        sigma = std::sqrt(l_vnorm);
+        double l_change = 0;
+        for (size_t j = 0; j < l_size2; j++) 
+        {
+            v[j] /= sigma;
+            l_change += (v[j] - v_prev[j]) * (v[j] - v_prev[j]);
+        }
+        if (l_change < 1e-24) break;
+    }
+
+    // NOTE ||K - s u v^T||^2 = ||K||^2 - s^2 for the dominant singular triplet.
+    if (l_norm2 - sigma * sigma > (double)tolerance * tolerance * l_norm2) return false;
+
+    double l_sign = 0;
+    for (size_t j = 0; j < l_size2; j++) l_sign += v[j];
+    l_sign = (l_sign < 0) ? -1.0 : 1.0;
+    o_column_kernel.resize(l_size1);
+    o_row_kernel.resize(l_size2);
+    for (size_t i = 0; i < l_size1; i++) o_column_kernel[i] = (NumericT)(l_sign * u[i] * std::sqrt(sigma));
+    for (size_t j = 0; j < l_size2; j++) o_row_kernel[j] = (NumericT)(l_sign * v[j] * std::sqrt(sigma));
+    return true;
+}
+
+// SECTION 03_001b Separable Matrix Convolution
+/** @brief Convolve the matrix by a separable kernel column_kernel * row_kernel^T in two 1-D passes, which costs k1 + k2 instead of k1 * k2 operations per pixel. The result is the same as convolve with the full 2D kernel.
+ * 
+ * @tparam ConvolType                             : EQUIV keeps the input size, INNER only keeps the pixels whose kernel lies inside of the input, OUTER every pixel whose kernel touches it
+ * @param  {viennacl::matrix<NumericT>} i_matrix  : Input matrix
+ * @param  {std::vector<TapT>} i_column_kernel    : Kernel taps along the rows (vertical), origin at the center tap. Integer pixels take float taps, see pixel_traits.
+ * @param  {std::vector<TapT>} i_row_kernel       : Kernel taps along the columns (horizontal), origin at the center tap
+ * @param  {viennacl::matrix<NumericT>} o_matrix  : Output matrix, resized to the output size if necessary. It may be the same object as i_matrix.
+ * @param  {viennacv::border_mode} border         : Extension of the input beyond its edges. Other backends than host memory only support the zero constant border.
+ * @param  {NumericT} border_value                : Input value beyond the edges for BORDER_CONSTANT
+ * 
+ * @example
+ * std::vector<float> blur = {0.25, 0.5, 0.25};
+ * viennacv::convolve_separable(vcl_matrix, blur, blur, vcl_result, viennacv::BORDER_REFLECT_101);
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First,
+            typename TapT>
+void convolve_separable(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const std::vector<TapT> & i_column_kernel,
+    const std::vector<TapT> & i_row_kernel,
+    viennacl::matrix<NumericT> & o_matrix,
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
+{
+    size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size1(), i_column_kernel.size()),
+            l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size2(), i_row_kernel.size());
+    assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolve_separable(): the kernel is larger than the INNER input!") );
+
+    if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+    {
+        // NOTE Rows beyond the edges of the intermediate are the filtered rows beyond the edges of the input, a constant border v becoming v * sum(row taps).
+        viennacl::linalg::host_based::detail::convolution_geometry 
+            t_row_geometry    = viennacv::detail::make_geometry(ConvolType, 1, i_row_kernel.size(), border, (double)border_value),
+            t_column_geometry = viennacv::detail::make_geometry(ConvolType, i_column_kernel.size(), 1, border, (double)border_value);
+        double l_row_sum = 0;
+        for (auto & tap: i_row_kernel) l_row_sum += (double)tap;
+        t_column_geometry.border_value *= l_row_sum;
+
+        typedef typename std::conditional<std::is_integral<NumericT>::value, typename pixel_traits<NumericT>::accumulator_type, NumericT>::type intermediate_type;
+        viennacl::matrix<intermediate_type> t_matrix(i_matrix.size1(), l_out_size2);
+        // NOTE Integer pixels keep the fixed-point intermediate of the row pass in the wide accumulator type, so rounding happens only once.
+        unsigned int l_bits = viennacv::detail::convolve_host<NumericT>(i_matrix, viennacv::detail::make_1d_taps<Direction::X>(i_row_kernel), t_matrix, 0, t_row_geometry);
+        if ((o_matrix.size1() != l_out_size1) || (o_matrix.size2() != l_out_size2))
+            o_matrix.resize(l_out_size1, l_out_size2, false);
+        viennacv::detail::convolve_host<NumericT>(t_matrix, viennacv::detail::make_1d_taps<Direction::Y>(i_column_kernel), o_matrix, l_bits, t_column_geometry);
+        return;
+    }
+
+    if constexpr (ConvolType == ConvolutionType::EQUIV && !std::is_integral<NumericT>::value)
+    {
+        if ((border != BORDER_CONSTANT) || (border_value != NumericT(0)))
+            throw viennacl::memory_exception("not implemented");
+        viennacl::matrix<NumericT> t_matrix(i_matrix.size1(), i_matrix.size2());
+        viennacv::detail::convolve_1d_pass<Direction::X>(i_matrix, i_row_kernel, t_matrix);
+        if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+            o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+        viennacv::detail::convolve_1d_pass<Direction::Y>(t_matrix, i_column_kernel, o_matrix);
+    }
+    else // NOTE Other backends only have the zero border EQUIV passes of floating point pixels.
+        throw viennacl::memory_exception("not implemented");
+} //function void viennacv::convolve_separable
+
+// SECTION 03_001c Separable Image Convolution
+/** @brief Convolve every color channel of the image by a separable kernel column_kernel * row_kernel^T, see 03_001b.
+ * 
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {std::vector<TapT>} i_column_kernel        : Kernel taps along the rows (vertical)
+ * @param  {std::vector<TapT>} i_row_kernel           : Kernel taps along the columns (horizontal)
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image
+ * @param  {viennacv::border_mode} border             : Extension of the input beyond its edges
+ * @param  {NumericT} border_value                    : Input value beyond the edges for BORDER_CONSTANT
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First,
+            typename TapT>
+void convolve_separable(
+    const viennacv::image_colpre<NumericT> & i_image,
+    const std::vector<TapT> & i_column_kernel,
+    const std::vector<TapT> & i_row_kernel,
+    viennacv::image_colpre<NumericT> & o_image,
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
+{
+    o_image.data_.resize(i_image.get_color_num());
+    for (size_t color=0; color< i_image.get_color_num(); color++) 
+        viennacv::convolve_separable<NumericT, ConvolType, optimize_level> 
+            (i_image.data_[color], i_column_kernel, i_row_kernel, o_image.data_[color], border, border_value);
+} //function void viennacv::convolve_separable
+
+
+// SECTION 03_003 FFT Image Convolution
+namespace detail
+{
+inline size_t next_power_of_2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+/** @brief Spectrum of the flipped kernel zero padded to l_pad_size1 x l_pad_size2 complex entries, interleaved (re, im) along the rows as viennacl::fft
+ *  expects. The last spectrum of each thread is kept with a copy of its kernel, so repeated calls with the same kernel and padded size skip its transform. */
+template <typename NumericT>
+const viennacl::matrix<NumericT> & kernel_spectrum(const viennacl::matrix<NumericT> & i_kernel, size_t l_pad_size1, size_t l_pad_size2)
+{
+    struct spectrum_entry
+    {
+        std::vector<NumericT>       kernel;
+        size_t                      size1 = 0, size2 = 0, pad_size1 = 0, pad_size2 = 0;
+        viennacl::matrix<NumericT>  spectrum;
+    };
+    static thread_local spectrum_entry t_entry;
+
+    size_t  l_size1 = i_kernel.size1(),
+            l_size2 = i_kernel.size2(),
+            l_kernel_pitch = i_kernel.internal_size2();
+    const NumericT * t_kernel_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(i_kernel);
+    std::vector<NumericT> t_kernel(l_size1 * l_size2);
+    for (size_t i = 0; i < l_size1; i++)
+        std::copy(t_kernel_ptr + i * l_kernel_pitch, t_kernel_ptr + i * l_kernel_pitch + l_size2, t_kernel.begin() + i * l_size2);
+    if ((t_entry.size1 == l_size1) && (t_entry.size2 == l_size2) && (t_entry.pad_size1 == l_pad_size1) && (t_entry.pad_size2 == l_pad_size2)
+        && (t_entry.kernel == t_kernel))
+        return t_entry.spectrum;
+
+    viennacl::matrix<NumericT> & t_spectrum = t_entry.spectrum;
+    t_entry.size1 = 0;                  // invalid until the new spectrum is complete
+    if ((t_spectrum.size1() != l_pad_size1) || (t_spectrum.size2() != 2 * l_pad_size2))
+        t_spectrum.resize(l_pad_size1, 2 * l_pad_size2, false);
+    t_spectrum.clear();
+    size_t  l_pitch = t_spectrum.internal_size2(),
+            l_half1 = (l_size1 - 1) / 2,
+            l_half2 = (l_size2 - 1) / 2;
+    NumericT * t_spectrum_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(t_spectrum);
+    // NOTE The kernel entry (r, c) is placed at (-(r-half1), -(c-half2)) modulo the padded size, turning the circular convolution into the correlation convolve computes.
+    for (size_t i = 0; i < l_size1; i++)
+    for (size_t j = 0; j < l_size2; j++)
+        t_spectrum_ptr[((l_pad_size1 + l_half1 - i) % l_pad_size1) * l_pitch + 2 * ((l_pad_size2 + l_half2 - j) % l_pad_size2)] = t_kernel[i * l_size2 + j];
+    viennacl::inplace_fft(t_spectrum);
+
+    t_entry.kernel.swap(t_kernel);
+    t_entry.size1 = l_size1;            t_entry.size2 = l_size2;
+    t_entry.pad_size1 = l_pad_size1;    t_entry.pad_size2 = l_pad_size2;
+    return t_spectrum;
+}
+} //namespace viennacv::detail
+
+// SECTION 03_003b FFT Matrix Convolution
+/** @brief Convolve the matrix by the 2D kernel in the frequency domain. The image and the flipped kernel are zero padded to power-of-2 sizes large enough that the circular convolution holds every zero-border output of the convolution type without wrapping around, transformed by viennacl::inplace_fft, multiplied and transformed back. INNER and OUTER outputs are windows of the same circular result. Only host memory is supported since the complex product is done by viennacl::linalg::host_based::multiply_complex.
+ * 
+ * convolve never selects this path by itself. Measured on the host, one padded pixel of viennacl::inplace_fft costs about 300 to 600 multiply-adds of the
+ * spatial engine per log2 of the padded size, so the spatial engine was faster for every kernel up to 41 x 41 on images up to 1000 x 1000
+ * (e.g. 0.33 s against 6.1 s for 41 x 41 on 500 x 500). The kernel spectrum is reused by calls of the same thread with the same kernel and padded size.
+ * 
+ * @tparam ConvolType                            : EQUIV keeps the input size, INNER only keeps the pixels whose kernel lies inside of the input, OUTER every pixel whose kernel touches it
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {viennacl::matrix<NumericT>} i_kernel : 2D kernel, the origin is the center entry
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized to the output size if necessary. It may be the same object as i_matrix.
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First>
+void convolve_fft(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const viennacl::matrix<NumericT> & i_kernel,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if ((viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY) || (viennacl::traits::active_handle_id(i_kernel) != viennacl::MAIN_MEMORY))
+        throw viennacl::memory_exception("not implemented");
+
+    size_t  l_row_num = i_matrix.size1(), 
+            l_column_num = i_matrix.size2(),
+            l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, l_row_num, i_kernel.size1()),
+            l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, l_column_num, i_kernel.size2());
+    assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolve_fft(): the kernel is larger than the INNER input!") );
+    size_t  l_pad_size1 = detail::next_power_of_2(l_row_num + i_kernel.size1() - 1),
+            l_pad_size2 = detail::next_power_of_2(l_column_num + i_kernel.size2() - 1);
+    // NOTE Output pixel (i, j) is the correlation centered at input pixel (i + row_offset, j + col_offset), found modulo the padded size.
+    viennacl::linalg::host_based::detail::convolution_geometry t_geometry 
+        = viennacv::detail::make_geometry(ConvolType, i_kernel.size1(), i_kernel.size2(), BORDER_CONSTANT, 0.0);
+
+    // NOTE Complex numbers are interleaved (re, im) along the rows as viennacl::fft expects.
+    viennacl::matrix<NumericT> t_image(l_pad_size1, 2 * l_pad_size2);
+    t_image.clear();
+    size_t  l_pitch = t_image.internal_size2(),
+            l_in_pitch = i_matrix.internal_size2();
+    NumericT * t_image_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(t_image);
+    const NumericT * t_in_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(i_matrix);
+    for (size_t i = 0; i < l_row_num; i++)
+    for (size_t j = 0; j < l_column_num; j++)
+        t_image_ptr[i * l_pitch + 2 * j] = t_in_ptr[i * l_in_pitch + j];
+
+    const viennacl::matrix<NumericT> & t_kernel = detail::kernel_spectrum(i_kernel, l_pad_size1, l_pad_size2);
+    viennacl::inplace_fft(t_image);
+    {
+        size_t l_size = t_image.internal_size1() * t_image.internal_size2();
+        viennacl::vector<NumericT> t_image_vec(t_image_ptr, viennacl::MAIN_MEMORY, l_size),
+                                   t_kernel_vec(const_cast<NumericT *>(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(t_kernel)), viennacl::MAIN_MEMORY, l_size);
+        viennacl::linalg::host_based::multiply_complex(t_image_vec, t_kernel_vec, t_image_vec);
+    }
+    viennacl::inplace_fft(t_image, NumericT(1.0));
+
+    if ((o_matrix.size1() != l_out_size1) || (o_matrix.size2() != l_out_size2))
+        o_matrix.resize(l_out_size1, l_out_size2, false);
+    NumericT l_scale = NumericT(1) / (NumericT)(l_pad_size1 * l_pad_size2);
+    size_t l_out_pitch = o_matrix.internal_size2();
+    NumericT * t_out_ptr = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(o_matrix);
+    for (size_t i = 0; i < l_out_size1; i++)
+    {
+        size_t l_row = (size_t)(((long)i + t_geometry.row_offset + (long)l_pad_size1) % (long)l_pad_size1);
+        for (size_t j = 0; j < l_out_size2; j++)
+            t_out_ptr[i * l_out_pitch + j] = t_image_ptr[l_row * l_pitch + 2 * (((long)j + t_geometry.col_offset + (long)l_pad_size2) % (long)l_pad_size2)] * l_scale;
+    }
+} //function void viennacv::convolve_fft
+
+
 // SECTION 03_002a Image Convolution, utilizing 01_002a
 /** @brief Convolve the image data by the 2D matrix kernel, which would be the base of image filter
  * 
  * @param  {viennacl::matrix<NumericT>} i_kernel    : 
  * @param  {std::vector<std::pair<size_t} undefined : 
  * @param  {size_t>>} ROIxy_vec                     : 
+ * @param  {viennacv::border_mode} border           : Extension of the input beyond its edges. Other backends than host memory only support the zero constant border.
+ * @param  {NumericT} border_value                  : Input value beyond the edges for BORDER_CONSTANT
+ * 
+ * The output has the input size for EQUIV, (size1 - k1 + 1) x (size2 - k2 + 1) for INNER and (size1 + k1 - 1) x (size2 + k2 - 1) for OUTER.
  * 
  * @example
  * vcl_MatrixT kernel(5, 5);
@@ -198,12 +1034,57 @@ void convolve(
     const viennacl::matrix<NumericT> & i_matrix,
     const viennacl::matrix<NumericT> & i_kernel,
     viennacl::matrix<NumericT> & o_matrix,
-    std::vector<std::pair<size_t, size_t>> ROIrc_vec = std::vector<std::pair<size_t, size_t>>() ) // REVIEW: ROIrc_vec may be combined with KerElementIdentity to make the same element compute together
+    std::vector<std::pair<size_t, size_t>> ROIrc_vec = std::vector<std::pair<size_t, size_t>>(), // REVIEW: ROIrc_vec may be combined with KerElementIdentity to make the same element compute together
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
 {
     // STUB 01 
     size_t l_kernel_size1 = (i_kernel.size1()-1)/2;
     size_t l_kernel_size2 = (i_kernel.size2()-1)/2;
+    bool   l_zero_border = (border == BORDER_CONSTANT) && (border_value == NumericT(0));
+
+    // NOTE A full rank-1 kernel (e.g. gaussian, box, sobel) is routed to the two 1-D passes of convolve_separable, O(k1+k2) instead of O(k1*k2) passes.
+    if constexpr (!KerElementIdentity && !std::is_integral<NumericT>::value)
+    {
+        std::vector<NumericT> t_column_kernel, t_row_kernel;
+        if (ROIrc_vec.empty() 
+            && ((ConvolType == ConvolutionType::EQUIV) || (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY))
+            && i_kernel.size1() * i_kernel.size2() > i_kernel.size1() + i_kernel.size2()
+            && viennacv::separate_kernel(i_kernel, t_column_kernel, t_row_kernel))
+        {
+            viennacv::convolve_separable<NumericT, ConvolType, optimize_level>(i_matrix, t_column_kernel, t_row_kernel, o_matrix, border, border_value);
+            return;
+        }
+    }
 
+    // NOTE Host memory goes to the cache-blocked engine, which reads every input pixel from cache once per tile instead of from memory once per tap.
+    //      It handles all convolution types and border modes.
+    if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+    {
+        size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size1(), i_kernel.size1()),
+                l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size2(), i_kernel.size2());
+        assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolve(): the kernel is larger than the INNER input!") );
+        std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> t_taps = viennacv::detail::make_kernel_taps(i_kernel, ROIrc_vec);
+        viennacl::linalg::host_based::detail::convolution_geometry t_geometry 
+            = viennacv::detail::make_geometry(ConvolType, i_kernel.size1(), i_kernel.size2(), border, (double)border_value);
+        if (&i_matrix == &o_matrix)
+        {
+            viennacl::matrix<NumericT> t_matrix(i_matrix);
+            if ((o_matrix.size1() != l_out_size1) || (o_matrix.size2() != l_out_size2))
+                o_matrix.resize(l_out_size1, l_out_size2, false);
+            viennacv::detail::convolve_host<NumericT>(t_matrix, t_taps, o_matrix, 0, t_geometry);
+        }
+        else
+        {
+            if ((o_matrix.size1() != l_out_size1) || (o_matrix.size2() != l_out_size2))
+                o_matrix.resize(l_out_size1, l_out_size2, false);
+            viennacv::detail::convolve_host<NumericT>(i_matrix, t_taps, o_matrix, 0, t_geometry);
+        }
+        return;
+    }
+    if ((ConvolType != ConvolutionType::EQUIV) || !l_zero_border)
+        throw viennacl::memory_exception("not implemented");
+    
     // NOTE Argument ROIrc_vec default empty case, all entries are filled in it here.
     if (ROIrc_vec.empty())
     {
@@ -222,7 +1103,7 @@ void convolve(
         int bias1 = l_row-l_kernel_size1; //TODO, here is int, make sure it will not leak
         int bias2 = l_column-l_kernel_size2;
         // REVIEW The following command is helpful to avoid unexpected too big kernel, however, I am not satisfactory with the if statement which may be a bottleneck in this loop.
-        if ((std::abs(bias1)>=l_kernel_size1) || (std::abs(bias2)>=l_kernel_size2)) continue;
+        if ((std::abs(bias1)>=(int)i_matrix.size1()) || (std::abs(bias2)>=(int)i_matrix.size2())) continue;
         if constexpr (ConvolType == ConvolutionType::EQUIV)
         {
             viennacl::range submat_row_range_from(std::max(bias1, 0), 
@@ -254,6 +1135,8 @@ void convolve(
  * @param  {viennacl::matrix<NumericT>} i_kernel    : 
  * @param  {std::vector<std::pair<size_t} undefined : 
  * @param  {size_t>>} ROIxy_vec                     : 
+ * @param  {viennacv::border_mode} border           : Extension of the input beyond its edges, see the viennacl::matrix version
+ * @param  {NumericT} border_value                  : Input value beyond the edges for BORDER_CONSTANT
  * 
  * @example
  * vcl_MatrixT kernel(5, 5);
@@ -271,25 +1154,471 @@ void convolve(
     const viennacv::image_colpre<NumericT> & i_image,
     const viennacl::matrix<NumericT> & i_kernel,
     viennacv::image_colpre<NumericT> & o_image,
-    std::vector<std::pair<size_t, size_t>> ROIrc_vec = std::vector<std::pair<size_t, size_t>>() )
+    std::vector<std::pair<size_t, size_t>> ROIrc_vec = std::vector<std::pair<size_t, size_t>>(),
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
 {
     o_image.data_.resize(i_image.get_color_num()); // REVIEW This may be the efficiency bottleneck which is safe but slow 
     // STUB 02 Multiply the scalar and contribute to the final image.
 
-    // NOTE Argument ROIrc_vec default empty case, all entries are filled in it here.
-    if (ROIrc_vec.empty())
-    {
-        for (size_t i = 0; i < i_kernel.size1(); i++)
-        for (size_t j = 0; j < i_kernel.size2(); j++)
-            ROIrc_vec.push_back(std::make_pair<int, int>(i, j));
-    }
+    // NOTE Argument ROIrc_vec default empty case is left to the matrix convolve, which may then take the separable path.
     for (size_t color=0; color< i_image.get_color_num(); color++) 
         viennacv::convolve<NumericT, ConvolType, KerElementIdentity, optimize_level> 
-            (i_image.data_[color], i_kernel, o_image.data_[color], ROIrc_vec);
+            (i_image.data_[color], i_kernel, o_image.data_[color], ROIrc_vec, border, border_value);
 } //function void viennacv::convolve
 
 
 
+// SECTION 03_004 Reusable convolution filter with workspace
+/** @brief A convolution kernel prepared once and applied to many images (e.g. per frame of a video). The kernel is read back, checked for separability and converted to host taps in the constructor, and the scratch matrices are owned by the filter and only reallocated when the image size changes, so repeated calls on host memory allocate nothing after the first one.
+ * 
+ * In-place application writes the result to a ping-pong buffer and copies it back instead of copying the input first. Separable kernels run their row pass into the intermediate buffer and their column pass straight into the target. Like convolve, it never takes the frequency domain path, see convolve_fft.
+ *
+ * Views (see viennacv::image_view) and regions of a matrix can be filtered without copying pixels. Since the scratch matrices are shared by all calls, threads
+ * filtering different tiles of an image must each use their own filter.
+ *
+ * @tparam NumericT         : Pixel type
+ * @tparam ConvolType       : EQUIV, INNER or OUTER, see convolve
+ * @tparam optimize_level   : Passed on to the fallback for non-host memory
+ * 
+ * @example
+ * viennacv::convolution_filter<float> blur(kernel, {}, viennacv::BORDER_REFLECT_101);
+ * for (auto & frame: frames)
+ *     blur.apply(frame);
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First>
+class convolution_filter
+{
+public:
+    typedef typename pixel_traits<NumericT>::tap_type           tap_type;
+    typedef typename pixel_traits<NumericT>::accumulator_type   accumulator_type;
+
+    // SECTION 03_004a Constructor
+    /** @brief Prepare a 2D kernel, optionally restricted to the ROI entries, see convolve. A full rank-1 kernel of floating point pixels is split into two 1-D passes. */
+    convolution_filter(const viennacl::matrix<NumericT> & i_kernel, 
+                       const std::vector<std::pair<size_t, size_t>> & ROIrc_vec = std::vector<std::pair<size_t, size_t>>(),
+                       border_mode border = BORDER_CONSTANT,
+                       NumericT border_value = NumericT(0))
+        : kernel_(i_kernel), ROIrc_vec_(ROIrc_vec), separable_(false), border_(border), border_value_(border_value), 
+          kernel_size1_(i_kernel.size1()), kernel_size2_(i_kernel.size2())
+    {
+        std::vector<NumericT> t_column_kernel, t_row_kernel;
+        if constexpr (!std::is_integral<NumericT>::value)
+        {
+            if (ROIrc_vec.empty() 
+                && i_kernel.size1() * i_kernel.size2() > i_kernel.size1() + i_kernel.size2()
+                && viennacv::separate_kernel(i_kernel, t_column_kernel, t_row_kernel))
+            {
+                set_separable(t_column_kernel, t_row_kernel);
+                return;
+            }
+        }
+        taps_ = viennacv::detail::make_host_taps<NumericT>(viennacv::detail::make_kernel_taps(i_kernel, ROIrc_vec));
+        geometry_ = viennacv::detail::make_geometry(ConvolType, kernel_size1_, kernel_size2_, border_, (double)border_value_);
+    }
+
+    /** @brief Prepare a separable kernel column_kernel * row_kernel^T, see convolve_separable. */
+    template <typename TapT>
+    convolution_filter(const std::vector<TapT> & i_column_kernel, 
+                       const std::vector<TapT> & i_row_kernel,
+                       border_mode border = BORDER_CONSTANT,
+                       NumericT border_value = NumericT(0))
+        : separable_(false), border_(border), border_value_(border_value), kernel_size1_(i_column_kernel.size()), kernel_size2_(i_row_kernel.size())
+    {
+        set_separable(i_column_kernel, i_row_kernel);
+    }
+
+    bool is_separable() const { return separable_; }
+
+    // SECTION 03_004b Apply
+    /** @brief o_matrix = i_matrix convolved by the kernel. o_matrix is resized if necessary and may be the same object as i_matrix. */
+    void apply(const viennacl::matrix<NumericT> & i_matrix, viennacl::matrix<NumericT> & o_matrix)
+    {
+        if (&i_matrix == &o_matrix)
+        {
+            apply(o_matrix);
+            return;
+        }
+        run(i_matrix, o_matrix);
+    }
+
+    /** @brief io_matrix = io_matrix convolved by the kernel, without copying the input. The result is copied back from the ping-pong buffer, so a
+     *  channel wrapping external memory (e.g. a mapped_image) keeps writing to that memory. */
+    void apply(viennacl::matrix<NumericT> & io_matrix)
+    {
+        // NOTE The column pass of a separable kernel only reads the intermediate buffer, so it can write the target directly.
+        if (separable_ && (viennacl::traits::active_handle_id(io_matrix) == viennacl::MAIN_MEMORY))
+        {
+            run(io_matrix, io_matrix);
+            return;
+        }
+        // NOTE Swapping the memory handles instead would hand wrapped caller memory to pingpong_ and detach it from io_matrix.
+        run(io_matrix, pingpong_);
+        prepare(io_matrix, pingpong_.size1(), pingpong_.size2());
+        io_matrix = pingpong_;
+    }
+
+    /** @brief Apply the kernel to every color channel, see apply(matrix, matrix). */
+    void apply(const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image)
+    {
+        if (&i_image == &o_image)
+        {
+            apply(o_image);
+            return;
+        }
+        o_image.data_.resize(i_image.get_color_num());
+        for (size_t color = 0; color < i_image.get_color_num(); color++)
+            apply(i_image.data_[color], o_image.data_[color]);
+    }
+
+    /** @brief Apply the kernel to every color channel in place. One channel sized buffer is reused for all channels. */
+    void apply(viennacv::image_colpre<NumericT> & io_image)
+    {
+        for (size_t color = 0; color < io_image.get_color_num(); color++)
+            apply(io_image.data_[color]);
+    }
+
+    // SECTION 03_004c Apply to views and regions
+    /** @brief o_view = i_view convolved by the kernel, for matrix_range or matrix_slice views of larger matrices. The view is treated as an image of its
+     *  own, i.e. the border mode applies at the edges of the view. Host memory only.
+     * @param  {viennacl::matrix_base<NumericT>} i_view : Input view
+     * @param  {viennacl::matrix_base<NumericT>} o_view : Output view of the output size of i_view. It must not overlap i_view.
+     */
+    void apply(const viennacl::matrix_base<NumericT> & i_view, viennacl::matrix_base<NumericT> & o_view)
+    {
+        if (viennacl::traits::active_handle_id(i_view) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_view.size1(), kernel_size1_),
+                l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_view.size2(), kernel_size2_);
+        assert( (o_view.size1() == l_out_size1) && (o_view.size2() == l_out_size2) && (l_out_size1 > 0) && (l_out_size2 > 0)
+                && bool("Check failed in convolution_filter::apply(): the output view does not have the output size!") );
+        if (separable_)
+        {
+            prepare(intermediate_, i_view.size1(), l_out_size2);
+            unsigned int l_bits = viennacv::detail::run_host_taps<NumericT>(i_view, row_taps_, intermediate_, 0, 0, size_t(-1), row_geometry_);
+            viennacv::detail::run_host_taps<NumericT>(intermediate_, column_taps_, o_view, l_bits, 0, size_t(-1), column_geometry_);
+        }
+        else
+            viennacv::detail::run_host_taps<NumericT>(i_view, taps_, o_view, 0, 0, size_t(-1), geometry_);
+    }
+
+    /** @brief Apply the kernel to every color channel of an image view, see apply(matrix_base, matrix_base) and viennacv::image_view. */
+    void apply(const viennacv::image_view<NumericT> & i_view, viennacv::image_view<NumericT> & o_view)
+    {
+        assert( (o_view.get_color_num() == i_view.get_color_num()) && bool("Check failed in convolution_filter::apply(): channel numbers differ!") );
+        for (size_t color = 0; color < i_view.get_color_num(); color++)
+            apply(i_view.channel(color), o_view.channel(color));
+    }
+
+    /** @brief Recompute only the output pixels inside a region, e.g. the part of a frame that changed. The result is the region of apply(i_matrix, o_matrix):
+     *  the input pixels around the region are read and the border mode applies at the edges of the whole matrix. Only the pixels needed by the region are
+     *  filtered, the rest of o_matrix is left untouched. Host memory only.
+     * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+     * @param  {image_rect} region                   : Region in output coordinates
+     * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, a different object than i_matrix. It is resized (and its content lost) only if it
+     *                                                 does not have the output size yet.
+     */
+    void apply(const viennacl::matrix<NumericT> & i_matrix, const image_rect & region, viennacl::matrix<NumericT> & o_matrix)
+    {
+        assert( (&i_matrix != &o_matrix) && bool("Check failed in convolution_filter::apply(): a region cannot be filtered in place!") );
+        if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        prepare(o_matrix, viennacv::detail::convolution_output_size(ConvolType, i_matrix.size1(), kernel_size1_),
+                          viennacv::detail::convolution_output_size(ConvolType, i_matrix.size2(), kernel_size2_));
+        assert( (region.top + region.rows <= o_matrix.size1()) && (region.left + region.columns <= o_matrix.size2())
+                && bool("Check failed in convolution_filter::apply(): the region exceeds the output!") );
+        if ((region.rows == 0) || (region.columns == 0))
+            return;
+
+        viennacl::matrix_range<viennacl::matrix<NumericT>> t_target(o_matrix, viennacl::range(region.top, region.top + region.rows),
+                                                                              viennacl::range(region.left, region.left + region.columns));
+        if (separable_)
+        {
+            // NOTE The row pass fills the intermediate rows the column pass reads, kernel_size1_ - 1 more than the region. Rows beyond the edges of the
+            //      matrix come out of the row pass as the border of the full intermediate would, see set_separable.
+            long l_half1 = ((long)kernel_size1_ - 1) / 2;
+            size_t l_rows = region.rows + kernel_size1_ - 1;
+            if ((region_intermediate_.size1() < l_rows) || (region_intermediate_.size2() < region.columns))
+                region_intermediate_.resize(std::max(region_intermediate_.size1(), l_rows), std::max(region_intermediate_.size2(), region.columns), false);
+            viennacl::matrix_range<viennacl::matrix<intermediate_type>> t_intermediate(region_intermediate_, viennacl::range(0, l_rows),
+                                                                                                              viennacl::range(0, region.columns));
+            geometry_type t_row_geometry = row_geometry_, t_column_geometry = column_geometry_;
+            t_row_geometry.row_offset = (long)region.top + column_geometry_.row_offset - l_half1;
+            t_row_geometry.col_offset += (long)region.left;
+            t_column_geometry.row_offset = l_half1;
+            t_column_geometry.col_offset = 0;
+            unsigned int l_bits = viennacv::detail::run_host_taps<NumericT>(i_matrix, row_taps_, t_intermediate, 0, 0, size_t(-1), t_row_geometry);
+            viennacv::detail::run_host_taps<NumericT>(t_intermediate, column_taps_, t_target, l_bits, 0, size_t(-1), t_column_geometry);
+        }
+        else
+        {
+            geometry_type t_geometry = geometry_;
+            t_geometry.row_offset += (long)region.top;
+            t_geometry.col_offset += (long)region.left;
+            viennacv::detail::run_host_taps<NumericT>(i_matrix, taps_, t_target, 0, 0, size_t(-1), t_geometry);
+        }
+    }
+
+    /** @brief Recompute the region of every color channel, see apply(matrix, image_rect, matrix). */
+    void apply(const viennacv::image_colpre<NumericT> & i_image, const image_rect & region, viennacv::image_colpre<NumericT> & o_image)
+    {
+        o_image.data_.resize(i_image.get_color_num());
+        o_image.image_format_ = i_image.image_format_;
+        for (size_t color = 0; color < i_image.get_color_num(); color++)
+            apply(i_image.data_[color], region, o_image.data_[color]);
+    }
+
+protected:
+    template <typename TapT>
+    void set_separable(const std::vector<TapT> & i_column_kernel, const std::vector<TapT> & i_row_kernel)
+    {
+        separable_ = true;
+        column_kernel_.assign(i_column_kernel.begin(), i_column_kernel.end());
+        row_kernel_.assign(i_row_kernel.begin(), i_row_kernel.end());
+        row_taps_ = viennacv::detail::make_host_taps<NumericT>(viennacv::detail::make_1d_taps<Direction::X>(row_kernel_));
+        column_taps_ = viennacv::detail::make_host_taps<NumericT, intermediate_type>(viennacv::detail::make_1d_taps<Direction::Y>(column_kernel_));
+        // NOTE Rows beyond the edges of the intermediate are filtered input rows, a constant border v becoming v * sum(row taps), see convolve_separable.
+        double l_row_sum = 0;
+        for (auto & tap: row_kernel_) l_row_sum += (double)tap;
+        row_geometry_ = viennacv::detail::make_geometry(ConvolType, 1, kernel_size2_, border_, (double)border_value_);
+        column_geometry_ = viennacv::detail::make_geometry(ConvolType, kernel_size1_, 1, border_, (double)border_value_ * l_row_sum);
+    }
+
+    /** @brief Resize a scratch matrix, keeping its memory if the size did not change. */
+    template <typename ScratchT>
+    static void prepare(viennacl::matrix<ScratchT> & t_matrix, size_t l_size1, size_t l_size2)
+    {
+        if ((t_matrix.size1() != l_size1) || (t_matrix.size2() != l_size2))
+            t_matrix.resize(l_size1, l_size2, false);
+    }
+
+    /** @brief Convolve into o_matrix, which is resized to the output size. The output may alias the input only for separable kernels on host memory, where it is resized after the row pass. */
+    void run(const viennacl::matrix<NumericT> & i_matrix, viennacl::matrix<NumericT> & o_matrix)
+    {
+        size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size1(), kernel_size1_),
+                l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_matrix.size2(), kernel_size2_);
+        assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolution_filter: the kernel is larger than the INNER input!") );
+        if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+        {
+            if (separable_)
+            {
+                prepare(intermediate_, i_matrix.size1(), l_out_size2);
+                unsigned int l_bits = viennacv::detail::run_host_taps<NumericT>(i_matrix, row_taps_, intermediate_, 0, 0, size_t(-1), row_geometry_);
+                prepare(o_matrix, l_out_size1, l_out_size2);
+                viennacv::detail::run_host_taps<NumericT>(intermediate_, column_taps_, o_matrix, l_bits, 0, size_t(-1), column_geometry_);
+            }
+            else
+            {
+                prepare(o_matrix, l_out_size1, l_out_size2);
+                viennacv::detail::run_host_taps<NumericT>(i_matrix, taps_, o_matrix, 0, 0, size_t(-1), geometry_);
+            }
+            return;
+        }
+        // NOTE Other backends go through the generic functions, which allocate their own temporaries.
+        if (separable_)
+        {
+            if constexpr (std::is_integral<NumericT>::value)
+                throw viennacl::memory_exception("not implemented");
+            else
+                viennacv::convolve_separable<NumericT, ConvolType, optimize_level>(i_matrix, column_kernel_, row_kernel_, o_matrix, border_, border_value_);
+        }
+        else
+            viennacv::convolve<NumericT, ConvolType, false, optimize_level>(i_matrix, kernel_, o_matrix, ROIrc_vec_, border_, border_value_);
+    }
+
+    // NOTE Integer pixels keep the row pass of a separable kernel in fixed point, see convolve_separable.
+    typedef typename std::conditional<std::is_integral<NumericT>::value, accumulator_type, NumericT>::type intermediate_type;
+    typedef viennacl::linalg::host_based::detail::convolution_geometry                                  geometry_type;
+
+    viennacl::matrix<NumericT>                      kernel_;
+    std::vector<std::pair<size_t, size_t>>          ROIrc_vec_;
+    bool                                            separable_;
+    border_mode                                     border_;
+    NumericT                                        border_value_;
+    size_t                                          kernel_size1_, kernel_size2_;
+    std::vector<tap_type>                           column_kernel_, row_kernel_;
+    detail::host_taps<NumericT>                     taps_, row_taps_;
+    detail::host_taps<NumericT, intermediate_type>  column_taps_;
+    geometry_type                                   geometry_, row_geometry_, column_geometry_;
+    viennacl::matrix<intermediate_type>             intermediate_;
+    viennacl::matrix<intermediate_type>             region_intermediate_;  // Only grows, regions use a view of it
+    viennacl::matrix<NumericT>                      pingpong_;
+}; //class viennacv::convolution_filter
+
+
+// SECTION 03_005 Batched convolution
+namespace detail
+{
+/** @brief Convolve a batch of same-sized host matrices by one tap list in a single dispatch of the host engine, see viennacl::linalg::host_based::convolve_batched.
+ *  The outputs must already have the output size of the geometry. */
+template <typename NumericT>
+void convolve_batched_host(
+    const std::vector<const viennacl::matrix_base<NumericT> *> & i_matrices,
+    const std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> & i_taps,
+    const std::vector<viennacl::matrix_base<NumericT> *> & o_matrices,
+    const viennacl::linalg::host_based::detail::convolution_geometry & geometry)
+{
+    for (auto & i_matrix: i_matrices)
+        if (viennacl::traits::active_handle_id(*i_matrix) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+    host_taps<NumericT> t_taps = make_host_taps<NumericT>(i_taps);
+    viennacl::linalg::host_based::convolve_batched(i_matrices, t_taps.taps, o_matrices, t_taps.bits, geometry);
+}
+} //namespace viennacv::detail
+
+/** @brief Convolve a stack of same-sized images, stored one below the other in a single matrix, by one 2D kernel. Every image has its own border, and all tiles of all images are processed in one parallel loop instead of one convolve call per image. Host memory only.
+ * 
+ * Output window and border handling are those of convolve, image by image: the output stack holds batch images of the output size of ConvolType.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_stack   : Input stack of size (batch * l_image_rows) x columns
+ * @param  {size_t} l_image_rows                  : Row number of one image
+ * @param  {viennacl::matrix<NumericT>} i_kernel  : 2D kernel, the origin is the center entry
+ * @param  {viennacl::matrix<NumericT>} o_stack   : Output stack, resized to batch * output rows x output columns if necessary. It must not be the same object as i_stack.
+ * @param  {std::vector<std::pair<size_t} undefined : 
+ * @param  {size_t>>} ROIrc_vec                   : Kernel entries to use, all if empty
+ * @param  {viennacv::border_mode} border         : Extension of every image beyond its own edges
+ * @param  {NumericT} border_value                : Input value beyond the edges for BORDER_CONSTANT
+ * 
+ * @example
+ * viennacl::matrix<float> patches(256 * 64, 64), result;
+ * viennacv::convolve_batched(patches, 64, kernel, result);
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First>
+void convolve_batched(
+    const viennacl::matrix<NumericT> & i_stack,
+    size_t l_image_rows,
+    const viennacl::matrix<NumericT> & i_kernel,
+    viennacl::matrix<NumericT> & o_stack,
+    const std::vector<std::pair<size_t, size_t>> & ROIrc_vec = std::vector<std::pair<size_t, size_t>>(),
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
+{
+    assert( (l_image_rows > 0) && (i_stack.size1() % l_image_rows == 0) 
+            && bool("Check failed in convolve_batched(): the stack is not a multiple of the image row number!") );
+    size_t  l_out_rows    = viennacv::detail::convolution_output_size(ConvolType, l_image_rows, i_kernel.size1()),
+            l_out_columns = viennacv::detail::convolution_output_size(ConvolType, i_stack.size2(), i_kernel.size2());
+    assert( (l_out_rows > 0) && (l_out_columns > 0) && bool("Check failed in convolve_batched(): the kernel is larger than the INNER input!") );
+    size_t l_batch = i_stack.size1() / l_image_rows;
+    if ((o_stack.size1() != l_batch * l_out_rows) || (o_stack.size2() != l_out_columns))
+        o_stack.resize(l_batch * l_out_rows, l_out_columns, false);
+
+    // NOTE The images are addressed by matrix_range views into the stacks, no pixel is copied.
+    viennacl::range l_in_columns(0, i_stack.size2()), l_out_columns_range(0, l_out_columns);
+    std::vector<viennacl::matrix_range<viennacl::matrix<NumericT>>> t_in_views, t_out_views;
+    t_in_views.reserve(l_batch); t_out_views.reserve(l_batch);
+    std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *> t_out;
+    for (size_t image = 0; image < l_batch; image++)
+    {
+        t_in_views.emplace_back(i_stack, viennacl::range(image * l_image_rows, (image + 1) * l_image_rows), l_in_columns);
+        t_out_views.emplace_back(o_stack, viennacl::range(image * l_out_rows, (image + 1) * l_out_rows), l_out_columns_range);
+    }
+    for (size_t image = 0; image < l_batch; image++)
+    {
+        t_in.push_back(&t_in_views[image]);
+        t_out.push_back(&t_out_views[image]);
+    }
+    viennacv::detail::convolve_batched_host(t_in, viennacv::detail::make_kernel_taps(i_kernel, ROIrc_vec), t_out,
+                                            viennacv::detail::make_geometry(ConvolType, i_kernel.size1(), i_kernel.size2(), border, (double)border_value));
+} //function void viennacv::convolve_batched
+
+/** @brief Convolve a batch of same-sized matrices by one 2D kernel in a single parallel dispatch, see the stack version. Host memory only.
+ * 
+ * @param  {std::vector<viennacl::matrix<NumericT>>} i_matrices : Input matrices, all of the same size
+ * @param  {viennacl::matrix<NumericT>} i_kernel                : 2D kernel, the origin is the center entry
+ * @param  {std::vector<viennacl::matrix<NumericT>>} o_matrices : Output matrices, resized to the output size of ConvolType if necessary. Must not be the same object as i_matrices.
+ * @param  {std::vector<std::pair<size_t} undefined             : 
+ * @param  {size_t>>} ROIrc_vec                                 : Kernel entries to use, all if empty
+ * @param  {viennacv::border_mode} border                       : Extension of every matrix beyond its edges
+ * @param  {NumericT} border_value                              : Input value beyond the edges for BORDER_CONSTANT
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First>
+void convolve_batched(
+    const std::vector<viennacl::matrix<NumericT>> & i_matrices,
+    const viennacl::matrix<NumericT> & i_kernel,
+    std::vector<viennacl::matrix<NumericT>> & o_matrices,
+    const std::vector<std::pair<size_t, size_t>> & ROIrc_vec = std::vector<std::pair<size_t, size_t>>(),
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
+{
+    if (i_matrices.empty()) return;
+    size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_matrices[0].size1(), i_kernel.size1()),
+            l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_matrices[0].size2(), i_kernel.size2());
+    assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolve_batched(): the kernel is larger than the INNER input!") );
+    o_matrices.resize(i_matrices.size());
+    std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *> t_out;
+    for (size_t image = 0; image < i_matrices.size(); image++)
+    {
+        assert( (i_matrices[image].size1() == i_matrices[0].size1()) && (i_matrices[image].size2() == i_matrices[0].size2())
+                && bool("Check failed in convolve_batched(): the images differ in size!") );
+        if ((o_matrices[image].size1() != l_out_size1) || (o_matrices[image].size2() != l_out_size2))
+            o_matrices[image].resize(l_out_size1, l_out_size2, false);
+        t_in.push_back(&i_matrices[image]);
+        t_out.push_back(&o_matrices[image]);
+    }
+    viennacv::detail::convolve_batched_host(t_in, viennacv::detail::make_kernel_taps(i_kernel, ROIrc_vec), t_out,
+                                            viennacv::detail::make_geometry(ConvolType, i_kernel.size1(), i_kernel.size2(), border, (double)border_value));
+} //function void viennacv::convolve_batched
+
+/** @brief Convolve every color channel of a batch of same-sized images by one 2D kernel, all channels of all images in a single parallel dispatch. Host memory only.
+ * 
+ * @param  {std::vector<viennacv::image_colpre<NumericT>>} i_images : Input images, all of the same size and color number
+ * @param  {viennacl::matrix<NumericT>} i_kernel                    : 2D kernel, the origin is the center entry
+ * @param  {std::vector<viennacv::image_colpre<NumericT>>} o_images : Output images, resized to the output size of ConvolType if necessary. Must not be the same object as i_images.
+ * @param  {std::vector<std::pair<size_t} undefined                 : 
+ * @param  {size_t>>} ROIrc_vec                                     : Kernel entries to use, all if empty
+ * @param  {viennacv::border_mode} border                           : Extension of every channel beyond its edges
+ * @param  {NumericT} border_value                                  : Input value beyond the edges for BORDER_CONSTANT
+ */
+template <  typename NumericT, 
+            viennacv::ConvolutionType ConvolType = EQUIV,
+            OptimizeLevel optimize_level = OptimizeLevel::First>
+void convolve_batched(
+    const std::vector<viennacv::image_colpre<NumericT>> & i_images,
+    const viennacl::matrix<NumericT> & i_kernel,
+    std::vector<viennacv::image_colpre<NumericT>> & o_images,
+    const std::vector<std::pair<size_t, size_t>> & ROIrc_vec = std::vector<std::pair<size_t, size_t>>(),
+    border_mode border = BORDER_CONSTANT,
+    NumericT border_value = NumericT(0))
+{
+    if (i_images.empty()) return;
+    size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_images[0].get_row_num(), i_kernel.size1()),
+            l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_images[0].get_column_num(), i_kernel.size2());
+    assert( (l_out_size1 > 0) && (l_out_size2 > 0) && bool("Check failed in convolve_batched(): the kernel is larger than the INNER input!") );
+    if (o_images.size() > i_images.size())
+        o_images.erase(o_images.begin() + i_images.size(), o_images.end());
+    while (o_images.size() < i_images.size())
+        o_images.emplace_back(i_images[o_images.size()].get_color_num(), l_out_size1, l_out_size2);
+    std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *> t_out;
+    for (size_t image = 0; image < i_images.size(); image++)
+    {
+        o_images[image].data_.resize(i_images[image].get_color_num());
+        o_images[image].image_format_ = i_images[image].image_format_;
+        for (size_t color = 0; color < i_images[image].get_color_num(); color++)
+        {
+            const viennacl::matrix<NumericT> & i_channel = i_images[image].data_[color];
+            viennacl::matrix<NumericT> & o_channel = o_images[image].data_[color];
+            assert( (i_channel.size1() == i_images[0].get_row_num()) && (i_channel.size2() == i_images[0].get_column_num())
+                    && bool("Check failed in convolve_batched(): the images differ in size!") );
+            if ((o_channel.size1() != l_out_size1) || (o_channel.size2() != l_out_size2))
+                o_channel.resize(l_out_size1, l_out_size2, false);
+            t_in.push_back(&i_channel);
+            t_out.push_back(&o_channel);
+        }
+    }
+    viennacv::detail::convolve_batched_host(t_in, viennacv::detail::make_kernel_taps(i_kernel, ROIrc_vec), t_out,
+                                            viennacv::detail::make_geometry(ConvolType, i_kernel.size1(), i_kernel.size2(), border, (double)border_value));
+} //function void viennacv::convolve_batched
+
+
 // SECTION 01_002b Image Convolution
 /** @brief the same as the convolve funciton 01_002a, just the default ROI becomes the whole matrix.
  * @param  {viennacl::matrix<NumericT>} i_kernel : 
@@ -310,8 +1639,21 @@ void convolve(
     std::vector<std::pair<size_t, size_t>> ROIrc_vec = std::vector<std::pair<size_t, size_t>>() )
 {
     // FIXME A strange bug here that if you use make_pair<size_t, size_t>, the compiler fails.
-    viennacv::image_colpre<NumericT> t_image(i_image);
-    viennacv::convolve<NumericT, ConvolType, KerElementIdentity, optimize_level>(t_image, i_kernel, i_image, ROIrc_vec);
+    // NOTE Every channel goes through the out-of-place matrix convolve (separable and KerElementIdentity paths included) into one
+    //      channel sized buffer and is copied back, so only one channel is allocated instead of a copy of the image, and channels wrapping
+    //      external memory keep writing to it.
+    viennacl::matrix<NumericT> t_channel;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        size_t  l_out_size1 = viennacv::detail::convolution_output_size(ConvolType, i_image.data_[color].size1(), i_kernel.size1()),
+                l_out_size2 = viennacv::detail::convolution_output_size(ConvolType, i_image.data_[color].size2(), i_kernel.size2());
+        if ((t_channel.size1() != l_out_size1) || (t_channel.size2() != l_out_size2))
+            t_channel.resize(l_out_size1, l_out_size2, false);
+        viennacv::convolve<NumericT, ConvolType, KerElementIdentity, optimize_level>(i_image.data_[color], i_kernel, t_channel, ROIrc_vec);
+        if ((i_image.data_[color].size1() != l_out_size1) || (i_image.data_[color].size2() != l_out_size2))
+            i_image.data_[color].resize(l_out_size1, l_out_size2, false);
+        i_image.data_[color] = t_channel;
+    }
 } //function image_colpre::convolve
 
 
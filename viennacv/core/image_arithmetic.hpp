@@ -0,0 +1,130 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_arithmetic.hpp
+    @brief Implementation of per-pixel arithmetic with saturation and pixel type conversion for image class
+*/
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "./image.hpp"
+
+
+// SECTION 01 Saturating arithmetic
+namespace viennacv
+{
+
+// SECTION 01_001 Saturating addition & subtraction for viennacl::matrix
+/** @brief o_matrix = saturate(i_matrix1 + i_matrix2), e.g. 200 + 100 = 255 for uint8_t pixels. Floating point pixels are simply added. 
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix1 : First operand
+ * @param  {viennacl::matrix<NumericT>} i_matrix2 : Second operand
+ * @param  {viennacl::matrix<NumericT>} o_matrix  : Result, resized if necessary. It may be one of the operands.
+ */
+template <typename NumericT>
+void add_saturate(
+    const viennacl::matrix<NumericT> & i_matrix1,
+    const viennacl::matrix<NumericT> & i_matrix2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if ((o_matrix.size1() != i_matrix1.size1()) || (o_matrix.size2() != i_matrix1.size2()))
+        o_matrix.resize(i_matrix1.size1(), i_matrix1.size2(), false);
+    if (viennacl::traits::active_handle_id(i_matrix1) == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::saturating_add(i_matrix1, i_matrix2, o_matrix, 1);
+    else if constexpr (!std::is_integral<NumericT>::value)
+        o_matrix = i_matrix1 + i_matrix2;
+    else
+        throw viennacl::memory_exception("not implemented");
+}
+
+/** @brief o_matrix = saturate(i_matrix1 - i_matrix2), e.g. 10 - 20 = 0 for uint8_t pixels. Floating point pixels are simply subtracted.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix1 : Minuend
+ * @param  {viennacl::matrix<NumericT>} i_matrix2 : Subtrahend
+ * @param  {viennacl::matrix<NumericT>} o_matrix  : Result, resized if necessary. It may be one of the operands.
+ */
+template <typename NumericT>
+void subtract_saturate(
+    const viennacl::matrix<NumericT> & i_matrix1,
+    const viennacl::matrix<NumericT> & i_matrix2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if ((o_matrix.size1() != i_matrix1.size1()) || (o_matrix.size2() != i_matrix1.size2()))
+        o_matrix.resize(i_matrix1.size1(), i_matrix1.size2(), false);
+    if (viennacl::traits::active_handle_id(i_matrix1) == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::saturating_add(i_matrix1, i_matrix2, o_matrix, -1);
+    else if constexpr (!std::is_integral<NumericT>::value)
+        o_matrix = i_matrix1 - i_matrix2;
+    else
+        throw viennacl::memory_exception("not implemented");
+}
+
+// SECTION 01_002 Saturating addition & subtraction for viennacv::image_colpre
+/** @brief Channel-wise add_saturate of two images of the same size */
+template <typename NumericT>
+void add_saturate(
+    const viennacv::image_colpre<NumericT> & i_image1,
+    const viennacv::image_colpre<NumericT> & i_image2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image1.get_color_num());
+    for (size_t color = 0; color < i_image1.get_color_num(); color++)
+        add_saturate(i_image1.data_[color], i_image2.data_[color], o_image.data_[color]);
+}
+
+/** @brief Channel-wise subtract_saturate of two images of the same size */
+template <typename NumericT>
+void subtract_saturate(
+    const viennacv::image_colpre<NumericT> & i_image1,
+    const viennacv::image_colpre<NumericT> & i_image2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image1.get_color_num());
+    for (size_t color = 0; color < i_image1.get_color_num(); color++)
+        subtract_saturate(i_image1.data_[color], i_image2.data_[color], o_image.data_[color]);
+}
+
+
+// SECTION 02 Pixel type conversion
+/** @brief Convert the pixel type of an image, e.g. uint8_t camera frames to float, or back with rounding and saturation. Single pass over all channels on host memory.
+ * 
+ * @param  {viennacv::image_colpre<SrcNumericT>} i_image   : Input image
+ * @param  {viennacv::image_colpre<DestNumericT>} o_image  : Output image, resized to the input
+ */
+template <typename DestNumericT, typename SrcNumericT>
+void convert_pixel_type(
+    const viennacv::image_colpre<SrcNumericT> & i_image,
+    viennacv::image_colpre<DestNumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    std::vector<viennacl::matrix_base<SrcNumericT> const *> t_in;
+    std::vector<viennacl::matrix_base<DestNumericT> *>      t_out;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        o_image.data_[color].resize(i_image.get_row_num(), i_image.get_column_num(), false);
+        t_in.push_back(&i_image.data_[color]);
+        t_out.push_back(&o_image.data_[color]);
+    }
+    if (viennacl::traits::active_handle_id(i_image.data_[0]) == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::copy_channels(t_in, t_out);
+    else
+        throw viennacl::memory_exception("not implemented");
+}
+
+} //namespace viennacv
@@ -0,0 +1,161 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_canny.hpp
+    @brief Implementation of the Canny edge detector with a reusable workspace and tile-parallel hysteresis
+*/
+
+#include <vector>
+#include <cmath>
+#include <type_traits>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/convolution_operations.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+#include "viennacv/core/image_kernel.hpp"
+
+
+// SECTION 01 Declare the Canny detector class
+namespace viennacv
+{
+
+/** @brief Canny edge detector: Gaussian blur, fused Sobel gradient with quantized orientation, non-maximum suppression with double threshold, and hysteresis. Host memory only.
+ *
+ * The blur, the gradient, the labels and the hysteresis stacks are owned by the detector and only reallocated when the image size changes, so running it on
+ * every frame of a video allocates nothing after the first frame. The hysteresis grows the edges inside tiles in parallel and then propagates them across
+ * tile borders in further parallel rounds, see viennacl::linalg::host_based::canny_hysteresis.
+ *
+ * @tparam NumericT : Pixel type. The gradient is computed in float for integer pixels.
+ *
+ * @example
+ * viennacv::canny_detector<unsigned char> canny(1.4, 40, 100);
+ * for (auto & frame: frames)
+ *     canny.apply(frame, edges);
+ */
+template <typename NumericT>
+class canny_detector
+{
+public:
+    typedef typename std::conditional<std::is_integral<NumericT>::value, float, NumericT>::type gradient_type;
+    typedef typename pixel_traits<NumericT>::tap_type                                           tap_type;
+
+    // SECTION 01_001 Constructor
+    /** @brief canny_detector constructor
+     * @param  {double} sigma     : Standard deviation of the Gaussian blur in pixels, 0 for no blur. The kernel is truncated at 3 sigma.
+     * @param  {double} low       : Lower threshold on the Sobel gradient magnitude, weak edge pixels are kept only if connected to strong ones
+     * @param  {double} high      : Upper threshold on the Sobel gradient magnitude, strong edge pixels
+     */
+    canny_detector(double sigma, double low, double high)
+        : low_((gradient_type)low), high_((gradient_type)high), blur_(*gaussian_kernel_cache<tap_type>::instance().taps(sigma), *gaussian_kernel_cache<tap_type>::instance().taps(sigma)), sigma_(sigma)
+    {
+    }
+
+    // SECTION 01_002 Apply
+    /** @brief Edge map of a matrix, edge pixels being the maximum pixel value (1 for floating point pixels, e.g. 255 for 8-bit pixels) and the others 0.
+     * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix on host memory
+     * @param  {viennacl::matrix<NumericT>} o_edges  : Edge map, resized if necessary. It may be the same object as i_matrix.
+     */
+    void apply(const viennacl::matrix<NumericT> & i_matrix, viennacl::matrix<NumericT> & o_edges)
+    {
+        if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        prepare(smoothed_, i_matrix);
+        prepare(magnitude_, i_matrix);
+        prepare(orientation_, i_matrix);
+        prepare(labels_, i_matrix);
+
+        const viennacl::matrix<NumericT> * t_input = &i_matrix;
+        if (sigma_ > 0)
+        {
+            blur_.apply(i_matrix, smoothed_);
+            t_input = &smoothed_;
+        }
+        viennacl::linalg::host_based::sobel_gradient<NumericT, gradient_type>(*t_input, NULL, NULL, &magnitude_, &orientation_, 4);
+        viennacl::linalg::host_based::canny_suppress(magnitude_, orientation_, low_, high_, labels_);
+        prepare(o_edges, i_matrix);
+        viennacl::linalg::host_based::canny_hysteresis(labels_, stacks_, (NumericT)viennacl::linalg::host_based::detail::pixel_range<NumericT>(), o_edges);
+    }
+
+    /** @brief Channel-wise edge maps of an image, see apply(matrix, matrix). */
+    void apply(const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image)
+    {
+        o_image.data_.resize(i_image.get_color_num());
+        o_image.image_format_ = i_image.image_format_;
+        for (size_t color = 0; color < i_image.get_color_num(); color++)
+            apply(i_image.data_[color], o_image.data_[color]);
+    }
+
+    /** @brief Gradient magnitude of the last image, valid until the next call to apply */
+    const viennacl::matrix<gradient_type> & get_magnitude() const { return magnitude_;};
+
+protected:
+    /** @brief Resize a workspace matrix to the size of the reference, keeping its memory if the size did not change. */
+    template <typename ScratchT>
+    static void prepare(viennacl::matrix<ScratchT> & t_matrix, const viennacl::matrix<NumericT> & i_reference)
+    {
+        if ((t_matrix.size1() != i_reference.size1()) || (t_matrix.size2() != i_reference.size2()))
+            t_matrix.resize(i_reference.size1(), i_reference.size2(), false);
+    }
+
+    gradient_type                       low_, high_;
+    viennacv::convolution_filter<NumericT> blur_;
+    double                              sigma_;
+    viennacl::matrix<NumericT>          smoothed_;
+    viennacl::matrix<gradient_type>     magnitude_, orientation_;
+    viennacl::matrix<unsigned char>     labels_;
+    std::vector<std::vector<long>>      stacks_;        // Hysteresis search stacks, one per tile
+}; //class viennacv::canny_detector
+
+
+// SECTION 02 Canny edge detector function
+namespace filter
+{
+/** @brief Canny edge detector for a single image, see viennacv::canny_detector. Video streams should keep a canny_detector to reuse its workspace.
+ *
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image on host memory
+ * @param  {double} sigma                             : Standard deviation of the Gaussian blur in pixels
+ * @param  {double} low                               : Lower threshold on the Sobel gradient magnitude
+ * @param  {double} high                              : Upper threshold on the Sobel gradient magnitude
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Channel-wise edge maps
+ */
+template <  typename NumericT>
+void canny(
+    const viennacv::image_colpre<NumericT> & i_image,
+    double sigma, double low, double high,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    viennacv::canny_detector<NumericT> t_detector(sigma, low, high);
+    t_detector.apply(i_image, o_image);
+}
+
+/** @brief Canny edge detector for a single matrix, see viennacv::canny_detector. */
+template <  typename NumericT>
+void canny(
+    const viennacl::matrix<NumericT> & i_matrix,
+    double sigma, double low, double high,
+    viennacl::matrix<NumericT> & o_edges)
+{
+    viennacv::canny_detector<NumericT> t_detector(sigma, low, high);
+    t_detector.apply(i_matrix, o_edges);
+}
+} //namespace viennacv::filter
+
+
+} //namespace viennacv
@@ -41,7 +41,13 @@ enum Direction {X, Y, Upright};
 enum image_format
 {
     RGB,
-    Gray
+    Gray,
+    YCbCr,          // ITU-R BT.601 full range, chroma centered at half of the pixel range
+    HSV,            // H, S and V all span the pixel range
+    BayerRGGB,      // Single channel Bayer mosaics, named by the colors of the 2 x 2 cell in row-major order
+    BayerBGGR,
+    BayerGRBG,
+    BayerGBRG
 };
 
 enum ConvolutionType
@@ -51,6 +57,29 @@ enum ConvolutionType
     EQUIV
 };
 
+enum border_mode
+{
+    BORDER_CONSTANT,        // vv|abcd|vv, v a given value (0 by default)
+    BORDER_REPLICATE,       // aa|abcd|dd
+    BORDER_REFLECT,         // ba|abcd|dc
+    BORDER_REFLECT_101,     // cb|abcd|cb
+    BORDER_WRAP             // cd|abcd|ab
+};
+
+enum interpolation
+{
+    NEAREST,
+    BILINEAR,
+    BICUBIC,
+    AREA            // Box average when shrinking, bilinear when enlarging. Warps and remap sample it as bilinear
+};
+
+enum image_layout
+{
+    PLANAR,         // CHW, each channel is a contiguous block of padded rows
+    INTERLEAVED     // HWC, the channels of a pixel are adjacent
+};
+
 
 } //namespace viennacv
 
@@ -19,9 +19,14 @@
 /** @file viennacv/core/image_filter.hpp
     @brief Implementation of filter convolution for image class
 */
+#include "viennacl/matrix.hpp"
 #include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/convolution_operations.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
 #include "./image.hpp"
 #include "./image_enum.hpp"
+#include "./image_integral.hpp"
+#include "./image_kernel.hpp"
 
 // SECTION 01b Declare the image class
 namespace viennacv
@@ -50,7 +55,7 @@ void sobel(
         viennacl::matrix<NumericT> sobel_kernel(3, 3);
         std::vector< std::vector<NumericT> > t_sobel_kernel;
         std::vector<std::pair<size_t, size_t>> t_ROIrc_vec;
-        if constexpr (Direct==viennacv::filter::Direction::X)
+        if constexpr (Direct==viennacv::Direction::X)
         {
             t_sobel_kernel.assign({
                 {-1.0, 0.0, 1.0}, 
@@ -62,7 +67,7 @@ void sobel(
                 std::make_pair(2, 0),   std::make_pair(2, 2)
             });
         }
-        else if constexpr (Direct == viennacv::filter::Direction::Y)
+        else if constexpr (Direct == viennacv::Direction::Y)
         {
             t_sobel_kernel.assign({
                 { 1.0, 2.0, 1.0}, 
@@ -84,6 +89,57 @@ void sobel(
 }
 
 
+// SECTION 01b Fused Sobel gradient
+/** @brief Sobel x and y derivatives, gradient magnitude and orientation computed together in one read of the input matrix, instead of two convolve calls plus whole-image passes for the magnitude. Any output may be NULL. Host memory only.
+ * 
+ * @tparam NumericT                                         : Numeric type of the input
+ * @tparam GradT                                            : Numeric type of the outputs, signed (e.g. float) since derivatives are signed
+ * @param  {viennacl::matrix<NumericT>} i_matrix            : Input matrix
+ * @param  {viennacl::matrix<GradT>} o_gx                   : x derivative in(i, j+1) - in(i, j-1), smoothed, same as sobel<X>
+ * @param  {viennacl::matrix<GradT>} o_gy                   : y derivative in(i-1, j) - in(i+1, j), smoothed, same as sobel<Y>
+ * @param  {viennacl::matrix<GradT>} o_magnitude            : sqrt(gx^2 + gy^2)
+ * @param  {viennacl::matrix<GradT>} o_orientation          : atan2(gy, gx), or the direction index 0..3 for 0, 45, 90, 135 degrees if quantize_orientation
+ * @param  {bool} quantize_orientation                      : Whether to quantize the orientation to 4 directions (e.g. for non-maximum suppression)
+ */
+template <  typename NumericT, typename GradT>
+void sobel_gradient(
+    const viennacl::matrix<NumericT> & i_matrix,
+    viennacl::matrix<GradT> * o_gx,
+    viennacl::matrix<GradT> * o_gy,
+    viennacl::matrix<GradT> * o_magnitude = NULL,
+    viennacl::matrix<GradT> * o_orientation = NULL,
+    bool quantize_orientation = false)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    for (viennacl::matrix<GradT> * o_matrix: {o_gx, o_gy, o_magnitude, o_orientation})
+        if (o_matrix && ((o_matrix->size1() != i_matrix.size1()) || (o_matrix->size2() != i_matrix.size2())))
+            o_matrix->resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::sobel_gradient<NumericT, GradT>(i_matrix, o_gx, o_gy, o_magnitude, o_orientation, quantize_orientation ? 4 : 0);
+}
+
+/** @brief Channel-wise sobel_gradient for viennacv::image_colpre, see the viennacl::matrix version. Any output may be NULL. */
+template <  typename NumericT, typename GradT>
+void sobel_gradient(
+    const viennacv::image_colpre<NumericT> & i_image,
+    viennacv::image_colpre<GradT> * o_gx,
+    viennacv::image_colpre<GradT> * o_gy,
+    viennacv::image_colpre<GradT> * o_magnitude = NULL,
+    viennacv::image_colpre<GradT> * o_orientation = NULL,
+    bool quantize_orientation = false)
+{
+    for (viennacv::image_colpre<GradT> * o_image: {o_gx, o_gy, o_magnitude, o_orientation})
+        if (o_image) o_image->data_.resize(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        sobel_gradient<NumericT, GradT>(i_image.data_[color], 
+                                        o_gx ? &o_gx->data_[color] : NULL, 
+                                        o_gy ? &o_gy->data_[color] : NULL, 
+                                        o_magnitude ? &o_magnitude->data_[color] : NULL, 
+                                        o_orientation ? &o_orientation->data_[color] : NULL, 
+                                        quantize_orientation);
+}
+
+
 // SECTION 02 Gaussian kernel convolution filter
 // SECTION 02_001 Gaussian 2D kernel generator
 /** @brief Gaussian kernel generator (more accurately, transformer). Input a viennacl::matrix and let it be distributed by gaussian 2D distribution coefficients. The origin is set to be the center of the matrix which requires this matrix to have odd row number and odd column number! 
@@ -95,33 +151,57 @@ void sobel(
 template <typename NumericT>
 inline void matrix_to_gaussian_kernel(viennacl::matrix<NumericT> & kernel, NumericT sigma)
 {
-    // REVIEW: This is a GPU version convolution kernel construtor, you may wanna know if CPU alone would be faster
-    size_t  ker_size1 = kernel.size1(), //i_image.get_row_num() * 2 + 1
-            ker_size1_half = ker_size1 / 2;
-    size_t  ker_size2 = kernel.size2(), //i_image.get_column_num() * 2 + 1
-            ker_size2_half = ker_size2 / 2;
-    viennacl::matrix<NumericT>  t_vcl_x(ker_size1, ker_size2),
-                                t_vcl_y(ker_size1, ker_size2);
-    std::vector< std::vector<NumericT> >    t_std_x(ker_size1), 
-                                            t_std_y(ker_size1);
-    for (size_t i = 0; i < ker_size1; i++)
+    // NOTE e^(-(x^2+y^2)/(2 sigma^2)) / (2pi sigma^2) is the outer product of two 1D gaussians, evaluated on the host and copied once.
+    std::vector<NumericT>   t_column = gaussian_kernel_cache<NumericT>::evaluate_taps(sigma, kernel.size1(), false),
+                            t_row    = gaussian_kernel_cache<NumericT>::evaluate_taps(sigma, kernel.size2(), false);
+    const double pi = 3.1415926535897;
+    std::vector< std::vector<NumericT> >    t_host(kernel.size1(), std::vector<NumericT>(kernel.size2()));
+    for (size_t i = 0; i < kernel.size1(); i++)
+        for (size_t j = 0; j < kernel.size2(); j++)
+            t_host[i][j] = (NumericT)(t_column[i] * t_row[j] / (2.0 * pi * std::pow(sigma, 2)));
+    viennacl::copy(t_host, kernel);
+}
+
+// SECTION 02_001c Recursive gaussian for viennacl::matrix
+/** @brief Approximate gaussian blur by the Young - van Vliet recursive filter, whose cost per pixel does not depend on sigma. Borders are treated as replicated instead of zero, and sigma below 0.5 is clamped to 0.5. The approximation is coarse below sigma ~ 2, where the separable gaussian is cheap anyway. Non-host memory falls back to a separable convolution truncated at 3 sigma.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {NumericT} sigma                      : Gaussian distribution sigma
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized to the input size if necessary. It may be the same object as i_matrix.
+ */
+template <typename NumericT>
+void gaussian_recursive(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const NumericT sigma,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::recursive_gaussian(i_matrix, sigma, o_matrix);
+    else
     {
-        t_std_y[i].resize(ker_size2);
-        t_std_x[i].resize(ker_size2);
-        for (size_t j = 0; j < ker_size2; j++)
-        {   // The coordinate is changed to another one with center of the kernel being the origin and the y axis direction is inversed.
-            t_std_y[i][j] = (NumericT) ker_size1_half - (NumericT) i;
-            t_std_x[i][j] = (NumericT) j - (NumericT) ker_size2_half;
-        }
-        
+        typename gaussian_kernel_cache<NumericT>::taps_pointer taps = gaussian_kernel_cache<NumericT>::instance().taps(sigma);
+        viennacv::convolve_separable<NumericT>(i_matrix, *taps, *taps, o_matrix);
     }
-    viennacl::copy(t_std_x, t_vcl_x); viennacl::copy(t_std_y, t_vcl_y);
-    const NumericT pi = 3.1415926535897;
-    using viennacl::linalg::element_prod, viennacl::linalg::element_div, viennacl::linalg::element_exp;
-    // NOTE the gausiian kernel calculation formqula is e^(-(x^2+y^2)/(2 sigma^2))  / (2pi sigma^2)
-    kernel = element_exp( (element_prod(t_vcl_x, t_vcl_x)+element_prod(t_vcl_y, t_vcl_y))  
-                        /   (-2.0 * std::pow(sigma,2))) ;
-    kernel /= 2.0 * pi * (NumericT)std::pow(sigma, 2);
+}
+
+// SECTION 02_001d Recursive gaussian for viennacv::image_colpre
+/** @brief Apply gaussian_recursive on every color channel of the image.
+ * 
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {NumericT} sigma                           : Gaussian distribution sigma
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image
+ */
+template <typename NumericT>
+void gaussian_recursive(
+    const viennacv::image_colpre<NumericT> & i_image,
+    const NumericT sigma,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        gaussian_recursive<NumericT>(i_image.data_[color], sigma, o_image.data_[color]);
 }
 
 // SECTION 02_002 Gaussian convolution for viennacl::matrix 
@@ -147,10 +227,20 @@ void gaussian(
         // REVIEW  It has been experimentally tested that for the gaussian kernel, there is no necessity to convolve the kernel all over the image.  
         size_t  ker_size1 = std::min(i_matrix.size1() * 2 + 1, (size_t)51), //i_image.get_row_num() * 2 + 1         
                 ker_size2 = std::min(i_matrix.size2() * 2 + 1, (size_t)51); //i_image.get_column_num() * 2 + 1
-        viennacl::matrix<NumericT>  gaussian_kernel(ker_size1, ker_size2);
-        viennacv::filter::matrix_to_gaussian_kernel<NumericT> (gaussian_kernel, sigma);
-        viennacv::convolve<NumericT, viennacv::ConvolutionType::EQUIV, false>
-                            (i_matrix, gaussian_kernel, o_matrix);
+        // NOTE The 2D gaussian is the outer product of two 1D gaussians, so two 1-D passes are enough. The normalized taps come from the kernel cache and
+        //      are only evaluated on the first call with this sigma and size.
+        typename gaussian_kernel_cache<NumericT>::taps_pointer  column_kernel = gaussian_kernel_cache<NumericT>::instance().taps(sigma, ker_size1),
+                                                                row_kernel    = gaussian_kernel_cache<NumericT>::instance().taps(sigma, ker_size2);
+        if (type == ConvolutionType::INNER)
+            viennacv::convolve_separable<NumericT, viennacv::ConvolutionType::INNER>(i_matrix, *column_kernel, *row_kernel, o_matrix);
+        else if (type == ConvolutionType::OUTER)
+            viennacv::convolve_separable<NumericT, viennacv::ConvolutionType::OUTER>(i_matrix, *column_kernel, *row_kernel, o_matrix);
+        else
+            viennacv::convolve_separable<NumericT, viennacv::ConvolutionType::EQUIV>(i_matrix, *column_kernel, *row_kernel, o_matrix);
+    }
+    else if constexpr (OptimizeL==OptimizeLevel::Second)
+    {
+        viennacv::filter::gaussian_recursive<NumericT>(i_matrix, sigma, o_matrix);
     }
     else
     {
@@ -181,6 +271,154 @@ void gaussian(
         gaussian<NumericT, OptimizeL>(i_image.data_[color], sigma, o_image.data_[color], type);
 }
 
+// SECTION 03 Box filter and local statistics from integral images
+// SECTION 03_001 Box filter for viennacl::matrix
+/** @brief Box filter, the same as convolve with a size1 x size2 all-ones kernel divided by size1 * size2 and a zero border, in O(1) per pixel through an integral image instead of O(size1 * size2). Host memory only.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {size_t} size1                        : Window rows
+ * @param  {size_t} size2                        : Window columns
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ */
+template <  typename NumericT>
+void box(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    viennacl::matrix<double> t_sum;
+    viennacv::integral_image(i_matrix, t_sum);
+    viennacv::box_statistics<double, NumericT>(t_sum, NULL, size1, size2, true, &o_matrix);
+}
+
+// SECTION 03_002 Local mean and variance for viennacl::matrix
+/** @brief Mean and variance of the size1 x size2 window around every pixel, over the window pixels inside the image, in O(1) per pixel. Host memory only.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix   : Input matrix
+ * @param  {size_t} size1                          : Window rows
+ * @param  {size_t} size2                          : Window columns
+ * @param  {viennacl::matrix<NumericT>} o_mean     : Local mean, or NULL
+ * @param  {viennacl::matrix<NumericT>} o_variance : Local variance, or NULL
+ */
+template <  typename NumericT>
+void local_statistics(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> * o_mean,
+    viennacl::matrix<NumericT> * o_variance = NULL)
+{
+    viennacl::matrix<double> t_sum, t_sqsum;
+    viennacv::integral_image(i_matrix, t_sum, o_variance ? &t_sqsum : NULL);
+    viennacv::box_statistics<double, NumericT>(t_sum, o_variance ? &t_sqsum : NULL, size1, size2, false, o_mean, o_variance);
+}
+
+// SECTION 03_003 Box filter and local statistics for viennacv::image_colpre
+/** @brief Channel-wise box filter for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void box(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        box<NumericT>(i_image.data_[color], size1, size2, o_image.data_[color]);
+}
+
+/** @brief Channel-wise local mean and variance for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void local_statistics(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> * o_mean,
+    viennacv::image_colpre<NumericT> * o_variance = NULL)
+{
+    for (viennacv::image_colpre<NumericT> * o_image: {o_mean, o_variance})
+        if (o_image) o_image->data_.resize(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        local_statistics<NumericT>(i_image.data_[color], size1, size2, 
+                                   o_mean ? &o_mean->data_[color] : NULL, 
+                                   o_variance ? &o_variance->data_[color] : NULL);
+}
+
+// SECTION 04 Noise removal
+// SECTION 04_001 Median filter for viennacl::matrix
+/** @brief Median over the (2 * radius + 1) x (2 * radius + 1) window around every pixel, ignoring the pixels outside the image. 8-bit pixels take constant time per pixel whatever the radius (at most 127). Host memory only.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {size_t} radius                       : Window radius
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ */
+template <  typename NumericT>
+void median(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t radius,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    assert( (!std::is_same<NumericT, unsigned char>::value || (radius <= 127)) && bool("Check failed in median(): the radius of the 8-bit median must not exceed 127!") );
+    if (&i_matrix == &o_matrix)
+    {
+        // NOTE The result is copied back rather than swapping memory handles, which would break channels wrapping external memory with another row padding.
+        viennacl::matrix<NumericT> t_matrix(i_matrix.size1(), i_matrix.size2());
+        viennacl::linalg::host_based::median(i_matrix, radius, t_matrix);
+        o_matrix = t_matrix;
+        return;
+    }
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::median(i_matrix, radius, o_matrix);
+}
+
+// SECTION 04_002 Bilateral filter for viennacl::matrix
+/** @brief Edge-preserving bilateral filter approximated on a bilateral grid, in constant time per pixel whatever sigma_space. Host memory only.
+ * 
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {double} sigma_space                  : Spatial standard deviation in pixels
+ * @param  {double} sigma_range                  : Range standard deviation in units of the pixel values, e.g. 0.1 for float pixels in [0, 1] or 25 for 8-bit pixels
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ */
+template <  typename NumericT>
+void bilateral(
+    const viennacl::matrix<NumericT> & i_matrix,
+    double sigma_space, double sigma_range,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::bilateral_grid(i_matrix, sigma_space, sigma_range, o_matrix);
+}
+
+// SECTION 04_003 Median and bilateral filters for viennacv::image_colpre
+/** @brief Channel-wise median filter for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void median(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t radius,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        median<NumericT>(i_image.data_[color], radius, o_image.data_[color]);
+}
+
+/** @brief Channel-wise bilateral filter for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void bilateral(
+    const viennacv::image_colpre<NumericT> & i_image,
+    double sigma_space, double sigma_range,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        bilateral<NumericT>(i_image.data_[color], sigma_space, sigma_range, o_image.data_[color]);
+}
+
 } //namespace viennacv::filter
 
 
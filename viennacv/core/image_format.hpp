@@ -20,35 +20,242 @@
     @brief Implementation of image format transformation for image class
 */
 
+#include <vector>
+#include <type_traits>
+
 #include "./image.hpp"
+#include "./image_layout.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
 
 
-// SECTION 01b Declare the image class
+// SECTION 01 Color conversion engine
 namespace viennacv
 {
+namespace detail
+{
+/** @brief Number of channels of an image format */
+inline size_t format_color_num(image_format l_image_format)
+{
+    switch (l_image_format)
+    {
+        case RGB: case YCbCr: case HSV: return 3;
+        default:                        return 1;
+    }
+}
+
+inline bool is_bayer(image_format l_image_format)
+{
+    return (l_image_format == BayerRGGB) || (l_image_format == BayerBGGR) || (l_image_format == BayerGRBG) || (l_image_format == BayerGBRG);
+}
+
+/** @brief Affine coefficients of the conversions that are linear in the pixel values, out_k = sum_c coefficients[k][c] * in_c + offsets[k]. Returns false for the others (HSV, Bayer). */
+template <typename NumericT>
+bool linear_color_coefficients(image_format i_image_format, image_format o_image_format, 
+                               std::vector<double> & coefficients, std::vector<double> & offsets)
+{
+    // NOTE The chroma of YCbCr is centered at half of the pixel range, e.g. 128 for unsigned char and 0.5 for float pixels in [0, 1].
+    double l_half = std::is_integral<NumericT>::value ? (viennacl::linalg::host_based::detail::pixel_range<NumericT>() + 1.0) / 2.0 : 0.5;
+    if ((i_image_format == RGB) && (o_image_format == Gray))
+    {
+        // 0.299 * R + 0.587 * G + 0.114 * B
+        coefficients = {0.2989, 0.5870, 0.1140};
+        offsets      = {0.0};
+    }
+    else if ((i_image_format == Gray) && (o_image_format == RGB))
+    {
+        coefficients = {1.0, 1.0, 1.0};
+        offsets      = {0.0, 0.0, 0.0};
+    }
+    else if ((i_image_format == RGB) && (o_image_format == YCbCr))
+    {
+        coefficients = { 0.299,     0.587,     0.114, 
+                        -0.168736, -0.331264,  0.5, 
+                         0.5,      -0.418688, -0.081312};
+        offsets      = {0.0, l_half, l_half};
+    }
+    else if ((i_image_format == YCbCr) && (o_image_format == RGB))
+    {
+        coefficients = {1.0,  0.0,       1.402, 
+                        1.0, -0.344136, -0.714136, 
+                        1.0,  1.772,     0.0};
+        offsets      = {-1.402 * l_half, (0.344136 + 0.714136) * l_half, -1.772 * l_half};
+    }
+    else
+        return false;
+    return true;
+}
+
+/** @brief Whether color_transform converts between the two formats in one step on host memory */
+template <typename NumericT>
+bool has_color_transform(image_format i_image_format, image_format o_image_format)
+{
+    std::vector<double> t_coefficients, t_offsets;
+    return linear_color_coefficients<NumericT>(i_image_format, o_image_format, t_coefficients, t_offsets)
+           || ((i_image_format == RGB) && (o_image_format == HSV)) || ((i_image_format == HSV) && (o_image_format == RGB))
+           || (is_bayer(i_image_format) && (o_image_format == RGB));
+}
+
+/** @brief Convert channels between two formats one of which is RGB, or from a Bayer mosaic to RGB. The output channels must have the input size and must not share memory with the input. */
+template <typename NumericT>
+void color_transform(
+    const std::vector<const viennacl::matrix_base<NumericT> *> & i_channels,
+    image_format i_image_format,
+    const std::vector<viennacl::matrix_base<NumericT> *> & o_channels,
+    image_format o_image_format)
+{
+    std::vector<double> t_coefficients, t_offsets;
+    bool l_linear = linear_color_coefficients<NumericT>(i_image_format, o_image_format, t_coefficients, t_offsets);
 
+    // NOTE On host memory every pixel is read once and written once by the engine in viennacl/linalg/host_based/image_operations.hpp.
+    if (viennacl::traits::active_handle_id(*i_channels[0]) == viennacl::MAIN_MEMORY)
+    {
+        if (l_linear)
+            viennacl::linalg::host_based::linear_color_transform(i_channels, t_coefficients, t_offsets, o_channels);
+        else if ((i_image_format == RGB) && (o_image_format == HSV))
+            viennacl::linalg::host_based::rgb_to_hsv(i_channels, o_channels);
+        else if ((i_image_format == HSV) && (o_image_format == RGB))
+            viennacl::linalg::host_based::hsv_to_rgb(i_channels, o_channels);
+        else if (is_bayer(i_image_format) && (o_image_format == RGB))
+        {
+            static const unsigned int l_patterns[4][4] = {{0, 1, 1, 2}, {2, 1, 1, 0}, {1, 0, 2, 1}, {1, 2, 0, 1}};
+            viennacl::linalg::host_based::demosaic_bilinear(*i_channels[0], l_patterns[i_image_format - BayerRGGB], o_channels);
+        }
+        else
+            throw viennacl::memory_exception("not implemented");
+        return;
+    }
+
+    // NOTE Other backends take the linear conversions through expression templates.
+    if constexpr (!std::is_integral<NumericT>::value)
+    {
+        if (l_linear)
+        {
+            size_t l_in = i_channels.size();
+            for (size_t k = 0; k < o_channels.size(); k++)
+            {
+                if (l_in == 1)
+                    *o_channels[k] = NumericT(t_coefficients[k]) * (*i_channels[0]);
+                else
+                    *o_channels[k] = NumericT(t_coefficients[k * l_in])     * (*i_channels[0]) 
+                                   + NumericT(t_coefficients[k * l_in + 1]) * (*i_channels[1]) 
+                                   + NumericT(t_coefficients[k * l_in + 2]) * (*i_channels[2]);
+                if (t_offsets[k] != 0)
+                    *o_channels[k] += viennacl::matrix<NumericT>(viennacl::scalar_matrix<NumericT>(o_channels[k]->size1(), o_channels[k]->size2(), NumericT(t_offsets[k])));
+            }
+            return;
+        }
+    }
+    throw viennacl::memory_exception("not implemented");
+}
+} //namespace viennacv::detail
+
+
+// SECTION 01b Image format transformation
+/** @brief Image format transformation for the viennacv::image_colpre class. Conversions between RGB and Gray, YCbCr or HSV and the demosaicing of Bayer mosaics to RGB run directly, every other pair goes through RGB. The input format is i_image.image_format_.
+ * 
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image, resized if necessary. It may be the same object as i_image.
+ * @param  {viennacv::image_format} o_image_format    : Output image format
+ * 
+ * Unsupported pairs (e.g. to a Bayer mosaic) throw viennacl::memory_exception and leave o_image untouched.
+ * 
+ * @example
+ * viennacv::image_colpre<unsigned char> raw(1, 480, 640), rgb(3, 480, 640);
+ * raw.image_format_ = viennacv::BayerRGGB;
+ * viennacv::format_transform(raw, rgb, viennacv::RGB);
+ */
 template <typename NumericT>
 void format_transform(
-    viennacv::image_colpre<NumericT> & i_image,
+    const viennacv::image_colpre<NumericT> & i_image,
     viennacv::image_colpre<NumericT> & o_image,
     image_format o_image_format)
 {
-    // TODO Here make the image initialization RGB
-    if ( (o_image_format == Gray))
+    image_format i_image_format = i_image.image_format_;
+    if (i_image_format == o_image_format)
     {
-        // 0.299 * R + 0.587 * G + 0.114 * B
-        // TODO: Make the variable private
-        o_image.data_.resize(1);
-        o_image.data_[0].resize(i_image.get_row_num(), i_image.get_column_num());
-        o_image.data_[0].clear();
-        o_image.data_[0] += 0.2989 * i_image.data_[0] + 
-                            0.5870 * i_image.data_[1] + 
-                            0.1140 * i_image.data_[2];
-        o_image.image_format_ = viennacv::Gray;
+        if (&i_image != &o_image) o_image = i_image;
+        return;
+    }
+    if ((i_image_format != RGB) && (o_image_format != RGB))
+    {
+        viennacv::image_colpre<NumericT> t_image(3, i_image.get_row_num(), i_image.get_column_num());
+        format_transform(i_image, t_image, RGB);
+        format_transform(t_image, o_image, o_image_format);
+        return;
+    }
+    if (&i_image == &o_image)
+    {
+        viennacv::image_colpre<NumericT> t_image(i_image.get_color_num(), i_image.get_row_num(), i_image.get_column_num());
+        format_transform(i_image, t_image, o_image_format);
+        o_image.swap(t_image);
+        return;
+    }
+
+    // NOTE An unsupported pair throws before the output is touched, so it never carries a format its pixels are not in.
+    if (!detail::has_color_transform<NumericT>(i_image_format, o_image_format))
+        throw viennacl::memory_exception("not implemented");
+    o_image.data_.resize(detail::format_color_num(o_image_format));
+    std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *> t_out;
+    for (auto & channel: i_image.data_)
+        t_in.push_back(&channel);
+    for (auto & channel: o_image.data_)
+    {
+        if ((channel.size1() != i_image.get_row_num()) || (channel.size2() != i_image.get_column_num()))
+            channel.resize(i_image.get_row_num(), i_image.get_column_num(), false);
+        t_out.push_back(&channel);
     }
+    detail::color_transform(t_in, i_image_format, t_out, o_image_format);
+    o_image.image_format_ = o_image_format;
 }
 
+/** @brief Image format transformation for the viennacv::image class, see the viennacv::image_colpre version. The input and output layouts may differ.
+ * 
+ * @param  {viennacv::image<NumericT, ILayout>} i_image : Input image
+ * @param  {viennacv::image<NumericT, OLayout>} o_image : Output image, must not be the input image. Left untouched if the pair is not supported.
+ * @param  {viennacv::image_format} o_image_format      : Output image format
+ */
+template <typename NumericT, image_layout ILayout, image_layout OLayout>
+void format_transform(
+    const viennacv::image<NumericT, ILayout> & i_image,
+    viennacv::image<NumericT, OLayout> & o_image,
+    image_format o_image_format)
+{
+    image_format i_image_format = i_image.image_format_;
+    if (i_image_format == o_image_format)
+    {
+        viennacv::convert_layout(i_image, o_image);
+        return;
+    }
+    if ((i_image_format != RGB) && (o_image_format != RGB))
+    {
+        viennacv::image<NumericT, OLayout> t_image(3, i_image.get_row_num(), i_image.get_column_num());
+        format_transform(i_image, t_image, RGB);
+        format_transform(t_image, o_image, o_image_format);
+        return;
+    }
 
-} //namespace viennacv
+    if (!detail::has_color_transform<NumericT>(i_image_format, o_image_format))
+        throw viennacl::memory_exception("not implemented");
+    o_image.resize(detail::format_color_num(o_image_format), i_image.get_row_num(), i_image.get_column_num());
+    std::vector<typename viennacv::image<NumericT, ILayout>::channel_type> t_in_channels;
+    std::vector<typename viennacv::image<NumericT, OLayout>::channel_type> t_out_channels;
+    t_in_channels.reserve(i_image.get_color_num()); t_out_channels.reserve(o_image.get_color_num());
+    std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *> t_out;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        t_in_channels.push_back(i_image.channel(color));
+        t_in.push_back(&t_in_channels.back());
+    }
+    for (size_t color = 0; color < o_image.get_color_num(); color++)
+    {
+        t_out_channels.push_back(o_image.channel(color));
+        t_out.push_back(&t_out_channels.back());
+    }
+    detail::color_transform(t_in, i_image_format, t_out, o_image_format);
+    o_image.image_format_ = o_image_format;
+}
 
 
+} //namespace viennacv
@@ -0,0 +1,191 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_histogram.hpp
+    @brief Implementation of histograms, global histogram equalization and contrast limited adaptive histogram equalization (CLAHE)
+*/
+
+#include <vector>
+#include <cassert>
+#include <type_traits>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Histograms
+namespace viennacv
+{
+
+namespace detail
+{
+/** @brief Value interval covered by the default histogram of a pixel type: [0, max + 1) for integers, [0, 1] for floating point pixels */
+template <typename NumericT>
+void histogram_interval(double & lo, double & hi)
+{
+    lo = 0;
+    hi = viennacl::linalg::host_based::detail::pixel_range<NumericT>() + (std::is_integral<NumericT>::value ? 1.0 : 0.0);
+}
+
+template <typename NumericT>
+void check_histogram_input(const viennacl::matrix<NumericT> & i_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+}
+} //namespace viennacv::detail
+
+// SECTION 01_001 Histogram
+/** @brief Histogram of a matrix with l_bin_num equal bins over [lo, hi], pixels outside of the interval being ignored. Host memory only.
+ *
+ * Every thread counts into private bins which are added up at the end, see viennacl::linalg::host_based::histogram.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {size_t} l_bin_num                    : Number of bins
+ * @param  {double} lo                           : Lower end of the first bin
+ * @param  {double} hi                           : Upper end of the last bin
+ * @return {std::vector<size_t>}                 : Pixel count of every bin
+ */
+template <typename NumericT>
+std::vector<size_t> histogram(const viennacl::matrix<NumericT> & i_matrix, size_t l_bin_num, double lo, double hi)
+{
+    detail::check_histogram_input(i_matrix);
+    assert( (l_bin_num > 0) && (hi > lo) && bool("Check failed in histogram(): empty bins!") );
+    std::vector<size_t> t_counts;
+    viennacl::linalg::host_based::histogram(i_matrix, l_bin_num, lo, hi, t_counts);
+    return t_counts;
+}
+
+/** @brief Histogram of a matrix over the whole pixel range, [0, max + 1) for integers (one bin per value for 8-bit pixels) and [0, 1] for floating point pixels. */
+template <typename NumericT>
+std::vector<size_t> histogram(const viennacl::matrix<NumericT> & i_matrix, size_t l_bin_num = 256)
+{
+    double lo, hi;
+    detail::histogram_interval<NumericT>(lo, hi);
+    return histogram(i_matrix, l_bin_num, lo, hi);
+}
+
+/** @brief Histogram of one channel of an image, see the viennacl::matrix version. */
+template <typename NumericT>
+std::vector<size_t> histogram(const viennacv::image_colpre<NumericT> & i_image, size_t l_color, size_t l_bin_num = 256)
+{
+    assert( (l_color < i_image.get_color_num()) && bool("Check failed in histogram(): no such channel!") );
+    return histogram(i_image.data_[l_color], l_bin_num);
+}
+
+
+// SECTION 02 Histogram equalization
+// SECTION 02_001 Global histogram equalization
+/** @brief Global histogram equalization: every pixel is mapped through the cumulative histogram of the matrix, the darkest occupied bin going to 0 and the
+ * brightest to the maximum pixel value. Floating point pixels are interpolated inside their bin, so they are not quantized to l_bin_num levels. Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ * @param  {size_t} l_bin_num                    : Number of histogram bins over the pixel range
+ */
+template <typename NumericT>
+void equalize_histogram(const viennacl::matrix<NumericT> & i_matrix, viennacl::matrix<NumericT> & o_matrix, size_t l_bin_num = 256)
+{
+    double lo, hi;
+    detail::histogram_interval<NumericT>(lo, hi);
+    std::vector<size_t> t_counts = histogram(i_matrix, l_bin_num, lo, hi);
+
+    // Cumulative distribution at the bin edges, starting at the first occupied bin
+    size_t l_total = 0, l_first = 0;
+    for (size_t b = 0; b < l_bin_num; b++)
+    {
+        if ((l_first == 0) && (t_counts[b] != 0))
+            l_first = t_counts[b];
+        l_total += t_counts[b];
+    }
+    std::vector<double> t_edges(l_bin_num + 1, 0.0);
+    size_t l_sum = 0;
+    for (size_t b = 0; b < l_bin_num; b++)
+    {
+        l_sum += t_counts[b];
+        if (l_total > l_first)
+            t_edges[b + 1] = (l_sum > l_first) ? (double)(l_sum - l_first) / (double)(l_total - l_first) : 0.0;
+        else
+            t_edges[b + 1] = (double)(b + 1) / (double)l_bin_num;    // constant or empty matrix: identity
+    }
+
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::apply_cumulative(i_matrix, t_edges, lo, hi, o_matrix);
+}
+
+/** @brief Channel-wise global histogram equalization for viennacv::image_colpre, see the viennacl::matrix version. Color images should rather be converted
+ * to a luma-chroma format and only have the luma channel equalized. */
+template <typename NumericT>
+void equalize_histogram(const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image, size_t l_bin_num = 256)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        equalize_histogram(i_image.data_[color], o_image.data_[color], l_bin_num);
+}
+
+// SECTION 02_002 Contrast limited adaptive histogram equalization
+/** @brief Contrast limited adaptive histogram equalization (CLAHE). Host memory only.
+ *
+ * The matrix is cut into l_tile_rows x l_tile_columns tiles whose clipped histograms and mapping tables are built in parallel; every pixel is then mapped
+ * through the tables of its four nearest tile centers, weighted bilinearly. See viennacl::linalg::host_based::clahe.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ * @param  {double} clip_limit                   : Histogram clip limit relative to the mean bin count, 0 for no contrast limit
+ * @param  {size_t} l_tile_rows                  : Number of tiles along the rows
+ * @param  {size_t} l_tile_columns               : Number of tiles along the columns
+ * @param  {size_t} l_bin_num                    : Number of histogram bins over the pixel range
+ */
+template <typename NumericT>
+void clahe(
+    const viennacl::matrix<NumericT> & i_matrix,
+    viennacl::matrix<NumericT> & o_matrix,
+    double clip_limit = 2.0,
+    size_t l_tile_rows = 8, size_t l_tile_columns = 8,
+    size_t l_bin_num = 256)
+{
+    detail::check_histogram_input(i_matrix);
+    assert( (l_tile_rows > 0) && (l_tile_columns > 0) && (l_bin_num > 0) && bool("Check failed in clahe(): empty tiles or bins!") );
+    double lo, hi;
+    detail::histogram_interval<NumericT>(lo, hi);
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::clahe(i_matrix, l_tile_rows, l_tile_columns, clip_limit, l_bin_num, lo, hi, o_matrix);
+}
+
+/** @brief Channel-wise CLAHE for viennacv::image_colpre, see the viennacl::matrix version. */
+template <typename NumericT>
+void clahe(
+    const viennacv::image_colpre<NumericT> & i_image,
+    viennacv::image_colpre<NumericT> & o_image,
+    double clip_limit = 2.0,
+    size_t l_tile_rows = 8, size_t l_tile_columns = 8,
+    size_t l_bin_num = 256)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        clahe(i_image.data_[color], o_image.data_[color], clip_limit, l_tile_rows, l_tile_columns, l_bin_num);
+}
+
+
+} //namespace viennacv
@@ -0,0 +1,142 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_integral.hpp
+    @brief Implementation of integral images (summed-area tables) and the O(1) box sums built on them
+*/
+
+#include <vector>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Integral image
+namespace viennacv
+{
+
+// SECTION 01_001 Integral image for viennacl::matrix
+/** @brief Integral image o_sum(i, j) = sum of i_matrix(r, c) over r < i, c < j, and optionally the integral of the squared pixels. The tables have one more row and column than the input, the first ones being zero.
+ *
+ * Host memory runs a row scan with the rows distributed over threads and then a column scan walking the memory row by row. Other backends scan every row and then every column with viennacl::linalg::inclusive_scan.
+ *
+ * @tparam NumericT                                   : Numeric type of the input
+ * @tparam SumT                                       : Numeric type of the tables, double by default so that float and integer pixels sum exactly enough for large images
+ * @param  {viennacl::matrix<NumericT>} i_matrix      : Input matrix
+ * @param  {viennacl::matrix<SumT>} o_sum             : Integral image, resized to (rows + 1) x (columns + 1) if necessary
+ * @param  {viennacl::matrix<SumT>} o_sqsum           : Integral image of the squared pixels, or NULL
+ */
+template <typename NumericT, typename SumT = double>
+void integral_image(
+    const viennacl::matrix<NumericT> & i_matrix,
+    viennacl::matrix<SumT> & o_sum,
+    viennacl::matrix<SumT> * o_sqsum = NULL)
+{
+    size_t l_row_num = i_matrix.size1() + 1,
+           l_column_num = i_matrix.size2() + 1;
+    for (viennacl::matrix<SumT> * o_matrix: {&o_sum, o_sqsum})
+        if (o_matrix && ((o_matrix->size1() != l_row_num) || (o_matrix->size2() != l_column_num)))
+            o_matrix->resize(l_row_num, l_column_num, false);
+
+    if (viennacl::traits::active_handle_id(i_matrix) == viennacl::MAIN_MEMORY)
+    {
+        viennacl::linalg::host_based::integral_image(i_matrix, o_sum, o_sqsum);
+        return;
+    }
+
+    // NOTE Rows and columns of the row-major tables are addressed as strided vectors sharing their memory.
+    viennacl::range l_inner1(1, l_row_num), l_inner2(1, l_column_num);
+    for (viennacl::matrix<SumT> * o_matrix: {&o_sum, o_sqsum})
+    {
+        if (!o_matrix) continue;
+        o_matrix->clear();
+        viennacl::matrix_range<viennacl::matrix<SumT>> t_inner(*o_matrix, l_inner1, l_inner2);
+        t_inner = i_matrix;
+        if (o_matrix == o_sqsum)
+            t_inner = viennacl::linalg::element_prod(t_inner, t_inner);
+        size_t l_pitch = o_matrix->internal_size2();
+        for (size_t row = 1; row < l_row_num; row++)
+        {
+            viennacl::vector_base<SumT> t_row(o_matrix->handle(), l_column_num - 1, row * l_pitch + 1, 1);
+            viennacl::linalg::inclusive_scan(t_row);
+        }
+        for (size_t column = 1; column < l_column_num; column++)
+        {
+            viennacl::vector_base<SumT> t_column(o_matrix->handle(), l_row_num - 1, l_pitch + column, l_pitch);
+            viennacl::linalg::inclusive_scan(t_column);
+        }
+    }
+} //function void viennacv::integral_image
+
+// SECTION 01_002 Integral image for viennacv::image_colpre
+/** @brief Channel-wise integral_image for viennacv::image_colpre, see the viennacl::matrix version.
+ *
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {viennacv::image_colpre<SumT>} o_sum       : Integral image of every channel
+ * @param  {viennacv::image_colpre<SumT>} o_sqsum     : Integral image of the squared pixels of every channel, or NULL
+ */
+template <typename NumericT, typename SumT = double>
+void integral_image(
+    const viennacv::image_colpre<NumericT> & i_image,
+    viennacv::image_colpre<SumT> & o_sum,
+    viennacv::image_colpre<SumT> * o_sqsum = NULL)
+{
+    o_sum.data_.resize(i_image.get_color_num());
+    if (o_sqsum) o_sqsum->data_.resize(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        integral_image<NumericT, SumT>(i_image.data_[color], o_sum.data_[color], o_sqsum ? &o_sqsum->data_[color] : NULL);
+} //function void viennacv::integral_image
+
+
+// SECTION 02 Box sums from integral images
+/** @brief Mean and variance of the window of size1 x size2 pixels around every pixel, computed in O(1) per pixel from integral images. Host memory only.
+ *
+ * @param  {viennacl::matrix<SumT>} i_sum             : Integral image
+ * @param  {viennacl::matrix<SumT>} i_sqsum           : Integral image of the squared pixels, only needed for the variance
+ * @param  {size_t} size1                             : Window rows, the origin being (size1 - 1) / 2 as for convolve
+ * @param  {size_t} size2                             : Window columns
+ * @param  {bool} divide_by_area                      : Divide by size1 * size2 (box filter with zero border) instead of the number of window pixels inside the image (local statistics)
+ * @param  {viennacl::matrix<OutNumericT>} o_mean     : Window mean, resized to the image size if necessary, or NULL
+ * @param  {viennacl::matrix<OutNumericT>} o_variance : Window variance, or NULL
+ */
+template <typename SumT, typename OutNumericT>
+void box_statistics(
+    const viennacl::matrix<SumT> & i_sum,
+    const viennacl::matrix<SumT> * i_sqsum,
+    size_t size1, size_t size2,
+    bool divide_by_area,
+    viennacl::matrix<OutNumericT> * o_mean,
+    viennacl::matrix<OutNumericT> * o_variance = NULL)
+{
+    if (viennacl::traits::active_handle_id(i_sum) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    assert( (size1 > 0) && (size2 > 0) && (!o_variance || i_sqsum)
+            && bool("Check failed in box_statistics(): the window must not be empty and the variance needs the squared integral image!") );
+    for (viennacl::matrix<OutNumericT> * o_matrix: {o_mean, o_variance})
+        if (o_matrix && ((o_matrix->size1() != i_sum.size1() - 1) || (o_matrix->size2() != i_sum.size2() - 1)))
+            o_matrix->resize(i_sum.size1() - 1, i_sum.size2() - 1, false);
+    viennacl::linalg::host_based::box_statistics(i_sum, i_sqsum, size1, size2, divide_by_area, o_mean, o_variance);
+} //function void viennacv::box_statistics
+
+
+} //namespace viennacv
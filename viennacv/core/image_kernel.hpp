@@ -0,0 +1,205 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_kernel.hpp
+    @brief Implementation of a cached Gaussian kernel factory producing analytic separable taps on the host
+*/
+
+#include <map>
+#include <list>
+#include <tuple>
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cassert>
+
+#include "viennacl/matrix.hpp"
+
+// Default number of kernels a gaussian_kernel_cache keeps:
+#ifndef VIENNACV_GAUSSIAN_CACHE_CAPACITY
+  #define VIENNACV_GAUSSIAN_CACHE_CAPACITY  64
+#endif
+
+
+// SECTION 01 Declare the Gaussian kernel cache class
+namespace viennacv
+{
+
+/** @brief Factory of normalized Gaussian kernels with a least recently used cache, keyed by sigma and kernel size, one cache per tap type. Thread safe.
+ *
+ * The 1D taps e^(-x^2/(2 sigma^2)) / sum are evaluated on the host once per key. The 2D kernel, only built when asked for, is the outer product of two tap
+ * vectors copied to a viennacl::matrix once. Kernels are handed out as shared pointers to constant objects, so a kernel evicted from the cache stays valid
+ * for as long as a caller holds it.
+ *
+ * @tparam TapT : Numeric type of the taps
+ *
+ * @example
+ * auto taps = viennacv::gaussian_kernel_cache<float>::instance().taps(1.5);   // 2 * ceil(3 sigma) + 1 taps
+ * viennacv::convolve_separable(frame, *taps, *taps, blurred);
+ */
+template <typename TapT>
+class gaussian_kernel_cache
+{
+public:
+    typedef std::shared_ptr<const std::vector<TapT>>        taps_pointer;
+    typedef std::shared_ptr<const viennacl::matrix<TapT>>   kernel_pointer;
+
+    // SECTION 01_001 Constructor
+    /** @brief gaussian_kernel_cache constructor
+     * @param  {size_t} l_capacity : Number of kernels kept, the least recently used being evicted first
+     */
+    explicit gaussian_kernel_cache(size_t l_capacity = VIENNACV_GAUSSIAN_CACHE_CAPACITY)
+        : capacity_(l_capacity)
+    {
+    }
+
+    /** @brief Process-wide cache of the tap type */
+    static gaussian_kernel_cache & instance()
+    {
+        static gaussian_kernel_cache t_cache;
+        return t_cache;
+    }
+
+    // SECTION 01_002 Kernels
+    /** @brief Normalized 1D Gaussian taps, the origin being the center tap
+     * @param  {double} sigma       : Gaussian distribution sigma, 0 for a single unit tap
+     * @param  {size_t} l_size      : Number of taps (odd), 0 for 2 * ceil(3 sigma) + 1
+     * @return {taps_pointer}       : Taps summing up to 1
+     */
+    taps_pointer taps(double sigma, size_t l_size = 0)
+    {
+        if (l_size == 0)
+            l_size = 2 * ((sigma > 0) ? (size_t)std::ceil(3 * sigma) : 0) + 1;
+        assert( (l_size % 2 == 1) && bool("Check failed in gaussian_kernel_cache::taps(): the kernel size must be odd!") );
+        std::lock_guard<std::mutex> t_lock(mutex_);
+        return taps_locked(sigma, l_size);
+    }
+
+    /** @brief Normalized 2D Gaussian kernel of l_size1 x l_size2 (both odd), the outer product of two tap vectors */
+    kernel_pointer kernel(double sigma, size_t l_size1, size_t l_size2)
+    {
+        assert( (l_size1 % 2 == 1) && (l_size2 % 2 == 1) && bool("Check failed in gaussian_kernel_cache::kernel(): the kernel size must be odd!") );
+        std::lock_guard<std::mutex> t_lock(mutex_);
+        taps_pointer t_column = taps_locked(sigma, l_size1), t_row = taps_locked(sigma, l_size2);
+        entry & t_entry = find_locked(key_type(sigma, l_size1, l_size2));
+        if (!t_entry.kernel)
+        {
+            std::vector<std::vector<TapT>> t_host(l_size1, std::vector<TapT>(l_size2));
+            for (size_t i = 0; i < l_size1; i++)
+                for (size_t j = 0; j < l_size2; j++)
+                    t_host[i][j] = (*t_column)[i] * (*t_row)[j];
+            std::shared_ptr<viennacl::matrix<TapT>> t_kernel = std::make_shared<viennacl::matrix<TapT>>(l_size1, l_size2);
+            viennacl::copy(t_host, *t_kernel);
+            t_entry.kernel = t_kernel;
+        }
+        return t_entry.kernel;
+    }
+
+    // SECTION 01_003 Cache management
+    /** @brief Change the capacity, evicting the least recently used kernels if necessary */
+    void set_capacity(size_t l_capacity)
+    {
+        std::lock_guard<std::mutex> t_lock(mutex_);
+        capacity_ = l_capacity;
+        evict();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> t_lock(mutex_);
+        order_.clear();
+        index_.clear();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> t_lock(mutex_);
+        return order_.size();
+    }
+
+    /** @brief Taps e^(-x^2/(2 sigma^2)) evaluated directly, without the cache, and divided by their sum unless normalized is false */
+    static std::vector<TapT> evaluate_taps(double sigma, size_t l_size, bool normalized = true)
+    {
+        std::vector<double> t_values(l_size, 1.0);
+        double l_half = (double)(l_size / 2), l_sum = 0;
+        for (size_t i = 0; i < l_size; i++)
+        {
+            if (sigma > 0)
+                t_values[i] = std::exp(-((double)i - l_half) * ((double)i - l_half) / (2 * sigma * sigma));
+            else
+                t_values[i] = ((double)i == l_half) ? 1.0 : 0.0;
+            l_sum += t_values[i];
+        }
+        std::vector<TapT> t_taps(l_size);
+        for (size_t i = 0; i < l_size; i++)
+            t_taps[i] = (TapT)(normalized ? t_values[i] / l_sum : t_values[i]);
+        return t_taps;
+    }
+
+protected:
+    typedef std::tuple<double, size_t, size_t>  key_type;       // sigma, size1, size2 (0 for taps)
+    struct entry
+    {
+        key_type        key;
+        taps_pointer    taps;
+        kernel_pointer  kernel;
+    };
+
+    taps_pointer taps_locked(double sigma, size_t l_size)
+    {
+        entry & t_entry = find_locked(key_type(sigma, l_size, 0));
+        if (!t_entry.taps)
+            t_entry.taps = std::make_shared<const std::vector<TapT>>(evaluate_taps(sigma, l_size));
+        return t_entry.taps;
+    }
+
+    /** @brief Entry of a key, created if missing and moved to the front of the recency list. The reference stays valid until the next call, which must happen under the lock. */
+    entry & find_locked(const key_type & i_key)
+    {
+        typename std::map<key_type, typename std::list<entry>::iterator>::iterator it = index_.find(i_key);
+        if (it != index_.end())
+        {
+            order_.splice(order_.begin(), order_, it->second);
+            return order_.front();
+        }
+        order_.push_front(entry{i_key, taps_pointer(), kernel_pointer()});
+        index_[i_key] = order_.begin();
+        evict(1);
+        return order_.front();
+    }
+
+    /** @brief Drop least recently used entries beyond the capacity, keeping at least l_keep entries */
+    void evict(size_t l_keep = 0)
+    {
+        while ((order_.size() > capacity_) && (order_.size() > l_keep))
+        {
+            index_.erase(order_.back().key);
+            order_.pop_back();
+        }
+    }
+
+    size_t                                                          capacity_;
+    std::list<entry>                                                order_;     // Most recently used first
+    std::map<key_type, typename std::list<entry>::iterator>         index_;
+    mutable std::mutex                                              mutex_;
+}; //class viennacv::gaussian_kernel_cache
+
+
+} //namespace viennacv
@@ -0,0 +1,149 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_label.hpp
+    @brief Implementation of connected-component labeling of binary masks with per-component statistics
+*/
+
+#include <vector>
+#include <cassert>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Declare the component labeler class
+namespace viennacv
+{
+
+/** @brief Statistics of one connected component */
+struct component_stats
+{
+    size_t label;
+    size_t area;                        // Number of pixels
+    size_t top, left, bottom, right;    // Inclusive bounding box
+    double centroid_row, centroid_col;
+};
+
+/** @brief Connected-component labeling of masks, non-zero pixels being foreground, with the area, bounding box and centroid of every component gathered in the labeling pass. Host memory only.
+ *
+ * Labels are numbered 1, 2, ... in raster order of the first pixel of every component, background pixels get 0. The union-find forest is owned by the
+ * labeler, so labeling a stream of masks of the same size allocates nothing after the first one. See viennacl::linalg::host_based::connected_components.
+ *
+ * @tparam NumericT : Pixel type of the masks
+ * @tparam LabelT   : Pixel type of the label images
+ *
+ * @example
+ * viennacv::component_labeler<unsigned char> labeler(8);
+ * std::vector<viennacv::component_stats> blobs;
+ * for (auto & mask: masks)
+ *     labeler.apply(mask, labels, &blobs);
+ */
+template <typename NumericT, typename LabelT = unsigned int>
+class component_labeler
+{
+public:
+    // SECTION 01_001 Constructor
+    /** @brief component_labeler constructor
+     * @param  {unsigned int} l_connectivity : 4 or 8
+     */
+    explicit component_labeler(unsigned int l_connectivity = 8)
+        : connectivity_(l_connectivity)
+    {
+        assert( ((l_connectivity == 4) || (l_connectivity == 8)) && bool("Check failed in component_labeler(): the connectivity must be 4 or 8!") );
+    }
+
+    // SECTION 01_002 Apply
+    /** @brief Label a mask
+     * @param  {viennacl::matrix<NumericT>} i_mask  : Input mask on host memory
+     * @param  {viennacl::matrix<LabelT>} o_labels  : Label image, resized if necessary
+     * @param  {std::vector<component_stats>} o_stats : Statistics of the components in label order, or NULL
+     * @return {size_t}                             : Number of components
+     */
+    size_t apply(const viennacl::matrix<NumericT> & i_mask, viennacl::matrix<LabelT> & o_labels, std::vector<component_stats> * o_stats = NULL)
+    {
+        if (viennacl::traits::active_handle_id(i_mask) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        if ((o_labels.size1() != i_mask.size1()) || (o_labels.size2() != i_mask.size2()))
+            o_labels.resize(i_mask.size1(), i_mask.size2(), false);
+        size_t l_component_num = viennacl::linalg::host_based::connected_components(i_mask, connectivity_, parent_, o_labels, o_stats ? &statistics_ : NULL);
+        if (o_stats)
+        {
+            o_stats->resize(l_component_num);
+            for (size_t k = 0; k < l_component_num; k++)
+            {
+                const viennacl::linalg::host_based::component_statistics & entry = statistics_[k];
+                (*o_stats)[k] = component_stats{k + 1, entry.area, (size_t)entry.row_min, (size_t)entry.col_min, (size_t)entry.row_max, (size_t)entry.col_max,
+                                                entry.row_sum / (double)entry.area, entry.col_sum / (double)entry.area};
+            }
+        }
+        return l_component_num;
+    }
+
+    /** @brief Label the single channel of a mask image, the label image being Gray. */
+    size_t apply(const viennacv::image_colpre<NumericT> & i_mask, viennacv::image_colpre<LabelT> & o_labels, std::vector<component_stats> * o_stats = NULL)
+    {
+        assert( (i_mask.get_color_num() == 1) && bool("Check failed in component_labeler::apply(): the mask must have a single channel!") );
+        o_labels.data_.resize(1);
+        o_labels.image_format_ = Gray;
+        return apply(i_mask.data_[0], o_labels.data_[0], o_stats);
+    }
+
+protected:
+    unsigned int                                                        connectivity_;
+    std::vector<long>                                                   parent_;        // Union-find forest over the pixels
+    std::vector<viennacl::linalg::host_based::component_statistics>     statistics_;
+}; //class viennacv::component_labeler
+
+
+// SECTION 02 Connected-component labeling function
+/** @brief Connected-component labeling of a single mask, see viennacv::component_labeler, which streams should keep to reuse its workspace.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_mask    : Input mask, non-zero pixels being foreground
+ * @param  {viennacl::matrix<LabelT>} o_labels    : Label image, 0 for the background
+ * @param  {std::vector<component_stats>} o_stats : Statistics of the components in label order, or NULL
+ * @param  {unsigned int} l_connectivity          : 4 or 8
+ * @return {size_t}                               : Number of components
+ */
+template <typename NumericT, typename LabelT>
+size_t connected_components(
+    const viennacl::matrix<NumericT> & i_mask,
+    viennacl::matrix<LabelT> & o_labels,
+    std::vector<component_stats> * o_stats = NULL,
+    unsigned int l_connectivity = 8)
+{
+    component_labeler<NumericT, LabelT> t_labeler(l_connectivity);
+    return t_labeler.apply(i_mask, o_labels, o_stats);
+}
+
+/** @brief Connected-component labeling of a single channel mask image, see the viennacl::matrix version. */
+template <typename NumericT, typename LabelT>
+size_t connected_components(
+    const viennacv::image_colpre<NumericT> & i_mask,
+    viennacv::image_colpre<LabelT> & o_labels,
+    std::vector<component_stats> * o_stats = NULL,
+    unsigned int l_connectivity = 8)
+{
+    component_labeler<NumericT, LabelT> t_labeler(l_connectivity);
+    return t_labeler.apply(i_mask, o_labels, o_stats);
+}
+
+
+} //namespace viennacv
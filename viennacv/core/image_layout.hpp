@@ -0,0 +1,222 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_layout.hpp
+    @brief Implementation of the image class with a single shared allocation in planar (CHW) or interleaved (HWC) layout
+*/
+
+#include <new>
+#include <cassert>
+#include <type_traits>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Declare the image class
+namespace viennacv
+{
+
+/** @brief Multi-channel image stored in one viennacl::matrix.
+ * 
+ * PLANAR stores the channels as color_num stacked blocks of rows, i.e. a (color_num * rows) x columns matrix, INTERLEAVED stores a rows x (columns * color_num) matrix.
+ * Rows are padded by viennacl::matrix to a multiple of viennacl::dense_padding_size entries, so every row starts on a SIMD-friendly boundary (the allocation itself is 32 byte aligned with VIENNACL_WITH_AVX2).
+ * Every channel is exposed without copying as a viennacl::matrix_range (PLANAR) or viennacl::matrix_slice (INTERLEAVED) of the shared matrix, so all matrix operations and filters of ViennaCL can work on it directly.
+ */
+template <typename NumericT, image_layout Layout = PLANAR>
+class image
+{
+public:
+    typedef typename std::conditional< Layout == PLANAR, 
+                                       viennacl::matrix_range<viennacl::matrix<NumericT>>, 
+                                       viennacl::matrix_slice<viennacl::matrix<NumericT>> >::type channel_type;
+
+    viennacl::matrix<NumericT> data_;    /** @brief The shared storage of all channels */
+    image_format image_format_;
+protected:
+    size_t color_num_;
+public:
+    inline size_t get_color_num()  const { return color_num_;};
+    inline size_t get_row_num()    const { return (Layout == PLANAR) ? data_.size1() / std::max(color_num_, (size_t)1) : data_.size1();};
+    inline size_t get_column_num() const { return (Layout == PLANAR) ? data_.size2() : data_.size2() / std::max(color_num_, (size_t)1);};
+    static constexpr image_layout layout() { return Layout; };
+
+public:
+    // SECTION 01_001 Constructor
+    /** @brief Constuctor for an uninitialized image of the given size
+     * @param  {size_t} l_color_num  : Channel number
+     * @param  {size_t} l_row_num    : Row number
+     * @param  {size_t} l_column_num : Column number
+     */
+    explicit image(size_t l_color_num = 1, size_t l_row_num = 0, size_t l_column_num = 0)
+    : image_format_(l_color_num == 1 ? Gray : RGB), color_num_(l_color_num)
+    {
+        resize(l_color_num, l_row_num, l_column_num);
+    }
+    /** @brief Constructor from a viennacv::image_colpre, all channels are packed in a single pass
+     * @param  {viennacv::image_colpre<NumericT>} i_image : 
+     */
+    explicit image(const image_colpre<NumericT> & i_image);
+
+    /** @brief Resize the image, the content is lost. An empty size releases the storage, so no stale pixels are left behind. */
+    void resize(size_t l_color_num, size_t l_row_num, size_t l_column_num)
+    {
+        color_num_ = l_color_num;
+        if (l_color_num * l_row_num * l_column_num == 0)
+        {
+            // NOTE viennacl::matrix can neither be resized to nor assigned from an empty size, so the storage is rebuilt in place.
+            typedef viennacl::matrix<NumericT> storage_type;
+            data_.~storage_type();
+            new (&data_) storage_type();
+        }
+        else if (Layout == PLANAR)
+            data_.resize(l_color_num * l_row_num, l_column_num, false);
+        else
+            data_.resize(l_row_num, l_column_num * l_color_num, false);
+    }
+
+    // SECTION 01_002 Zero-copy channel views
+    /** @brief View of one channel, sharing memory with the image. ViennaCL views are always writable, so a view of a const image does not make it
+     *  read-only: writing through the returned view modifies the image.
+     * @param  {size_t} color  : Channel index
+     * @return {channel_type}  : matrix_range for PLANAR, matrix_slice with column stride color_num for INTERLEAVED
+     */
+    channel_type channel(size_t color) const
+    {
+        assert( (color < color_num_) && bool("Check failed in image::channel(): no such channel!") );
+        if constexpr (Layout == PLANAR)
+            return channel_type(data_, viennacl::range(color * get_row_num(), (color + 1) * get_row_num()),
+                                       viennacl::range(0, get_column_num()));
+        else
+            return channel_type(data_, viennacl::slice(0, 1, get_row_num()),
+                                       viennacl::slice(color, color_num_, get_column_num()));
+    }
+};
+
+
+// SECTION 02 Layout conversion
+namespace detail
+{
+/** @brief Copy all channels between two multi-channel containers of equal size, in a single host pass if possible, otherwise channel by channel. */
+template <typename NumericT, typename SrcChannelsT, typename DestChannelsT>
+void copy_channels(const SrcChannelsT & i_channels, DestChannelsT & o_channels)
+{
+    if (viennacl::traits::active_handle_id(*i_channels[0]) == viennacl::MAIN_MEMORY
+        && viennacl::traits::active_handle_id(*o_channels[0]) == viennacl::MAIN_MEMORY)
+    {
+        std::vector<viennacl::matrix_base<NumericT> const *> t_in(i_channels.begin(), i_channels.end());
+        std::vector<viennacl::matrix_base<NumericT> *>       t_out(o_channels.begin(), o_channels.end());
+        viennacl::linalg::host_based::copy_channels(t_in, t_out);
+    }
+    else
+        for (size_t color = 0; color < i_channels.size(); color++)
+            *o_channels[color] = *i_channels[color];
+}
+} //namespace viennacv::detail
+
+// SECTION 02_001 image_colpre -> image
+/** @brief Conversion: image_colpre -> image, single pass over the pixels on host memory
+ * 
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {viennacv::image<NumericT, Layout>} o_image : Output image, resized to the input
+ */
+template <typename NumericT, image_layout Layout>
+void convert_layout(const image_colpre<NumericT> & i_image, image<NumericT, Layout> & o_image)
+{
+    o_image.resize(i_image.get_color_num(), i_image.get_row_num(), i_image.get_column_num());
+    o_image.image_format_ = i_image.image_format_;
+    std::vector<typename image<NumericT, Layout>::channel_type> t_channels;
+    std::vector<viennacl::matrix_base<NumericT> const *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *>       t_out;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        t_channels.push_back(o_image.channel(color));
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        t_in.push_back(&i_image.data_[color]);
+        t_out.push_back(&t_channels[color]);
+    }
+    detail::copy_channels<NumericT>(t_in, t_out);
+}
+
+// SECTION 02_002 image -> image_colpre
+/** @brief Conversion: image -> image_colpre, single pass over the pixels on host memory
+ * 
+ * @param  {viennacv::image<NumericT, Layout>} i_image : Input image
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image, resized to the input
+ */
+template <typename NumericT, image_layout Layout>
+void convert_layout(const image<NumericT, Layout> & i_image, image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    std::vector<typename image<NumericT, Layout>::channel_type> t_channels;
+    std::vector<viennacl::matrix_base<NumericT> const *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *>       t_out;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        o_image.data_[color].resize(i_image.get_row_num(), i_image.get_column_num(), false);
+        t_channels.push_back(i_image.channel(color));
+    }
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        t_in.push_back(&t_channels[color]);
+        t_out.push_back(&o_image.data_[color]);
+    }
+    detail::copy_channels<NumericT>(t_in, t_out);
+}
+
+// SECTION 02_003 image<LayoutA> -> image<LayoutB>
+/** @brief Conversion between the PLANAR and INTERLEAVED layouts, single pass over the pixels on host memory
+ * 
+ * @param  {viennacv::image<NumericT, ILayout>} i_image : Input image
+ * @param  {viennacv::image<NumericT, OLayout>} o_image : Output image, resized to the input
+ */
+template <typename NumericT, image_layout ILayout, image_layout OLayout>
+void convert_layout(const image<NumericT, ILayout> & i_image, image<NumericT, OLayout> & o_image)
+{
+    o_image.resize(i_image.get_color_num(), i_image.get_row_num(), i_image.get_column_num());
+    o_image.image_format_ = i_image.image_format_;
+    std::vector<typename image<NumericT, ILayout>::channel_type> t_in_channels;
+    std::vector<typename image<NumericT, OLayout>::channel_type> t_out_channels;
+    std::vector<viennacl::matrix_base<NumericT> const *> t_in;
+    std::vector<viennacl::matrix_base<NumericT> *>       t_out;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        t_in_channels.push_back(i_image.channel(color));
+        t_out_channels.push_back(o_image.channel(color));
+    }
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        t_in.push_back(&t_in_channels[color]);
+        t_out.push_back(&t_out_channels[color]);
+    }
+    detail::copy_channels<NumericT>(t_in, t_out);
+}
+
+// SECTION 01_001b Constructor <- viennacv::image_colpre
+template <typename NumericT, image_layout Layout>
+image<NumericT, Layout>::image(const image_colpre<NumericT> & i_image)
+: image_format_(i_image.image_format_), color_num_(i_image.get_color_num())
+{
+    convert_layout(i_image, *this);
+}
+
+} //namespace viennacv
@@ -0,0 +1,148 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_morphology.hpp
+    @brief Implementation of erosion, dilation, opening and closing with rectangular structuring elements in constant time per pixel
+*/
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Morphological operators
+namespace viennacv
+{
+namespace morphology
+{
+
+// SECTION 01_001 Erosion and dilation for viennacl::matrix
+/** @brief Erosion, the minimum over the size1 x size2 rectangle around every pixel with the origin at ((size1 - 1) / 2, (size2 - 1) / 2), ignoring the pixels outside the image.
+ * About three comparisons per pixel and direction whatever the element size (van Herk/Gil-Werman). Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {size_t} size1                        : Rows of the structuring element
+ * @param  {size_t} size2                        : Columns of the structuring element
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. It may be the same object as i_matrix.
+ */
+template <  typename NumericT>
+void erode(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    assert( (size1 > 0) && (size2 > 0) && bool("Check failed in erode(): the structuring element must not be empty!") );
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::morphology(i_matrix, size1, size2, false, o_matrix);
+}
+
+/** @brief Dilation, the maximum over the size1 x size2 rectangle around every pixel, see erode. */
+template <  typename NumericT>
+void dilate(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    assert( (size1 > 0) && (size2 > 0) && bool("Check failed in dilate(): the structuring element must not be empty!") );
+    if ((o_matrix.size1() != i_matrix.size1()) || (o_matrix.size2() != i_matrix.size2()))
+        o_matrix.resize(i_matrix.size1(), i_matrix.size2(), false);
+    viennacl::linalg::host_based::morphology(i_matrix, size1, size2, true, o_matrix);
+}
+
+// SECTION 01_002 Opening and closing for viennacl::matrix
+/** @brief Opening, erode then dilate, removes bright details smaller than the structuring element. The second step runs in place on o_matrix. */
+template <  typename NumericT>
+void open(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    erode(i_matrix, size1, size2, o_matrix);
+    dilate(o_matrix, size1, size2, o_matrix);
+}
+
+/** @brief Closing, dilate then erode, fills dark holes smaller than the structuring element. The second step runs in place on o_matrix. */
+template <  typename NumericT>
+void close(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t size1, size_t size2,
+    viennacl::matrix<NumericT> & o_matrix)
+{
+    dilate(i_matrix, size1, size2, o_matrix);
+    erode(o_matrix, size1, size2, o_matrix);
+}
+
+// SECTION 01_003 Morphological operators for viennacv::image_colpre
+/** @brief Channel-wise erode for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void erode(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        erode<NumericT>(i_image.data_[color], size1, size2, o_image.data_[color]);
+}
+
+/** @brief Channel-wise dilate for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void dilate(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        dilate<NumericT>(i_image.data_[color], size1, size2, o_image.data_[color]);
+}
+
+/** @brief Channel-wise opening for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void open(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    erode(i_image, size1, size2, o_image);
+    dilate(o_image, size1, size2, o_image);
+}
+
+/** @brief Channel-wise closing for viennacv::image_colpre, see the viennacl::matrix version. */
+template <  typename NumericT>
+void close(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t size1, size_t size2,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    dilate(i_image, size1, size2, o_image);
+    erode(o_image, size1, size2, o_image);
+}
+
+} //namespace viennacv::morphology
+
+
+} //namespace viennacv
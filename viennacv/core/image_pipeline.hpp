@@ -0,0 +1,329 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_pipeline.hpp
+    @brief Implementation of a streaming filter pipeline executed row band by row band, with consecutive frames overlapping across threads
+*/
+
+#include <vector>
+#include <functional>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/convolution_operations.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+#include "viennacv/core/image_format.hpp"
+
+// Default number of rows of the bands a pipeline passes from stage to stage:
+#ifndef VIENNACV_PIPELINE_BAND_ROWS
+  #define VIENNACV_PIPELINE_BAND_ROWS  32
+#endif
+
+
+// SECTION 01 Declare the image pipeline class
+namespace viennacv
+{
+
+namespace detail
+{
+/** @brief Views of the rows [row_begin, row_end) of every channel of an image */
+template <typename NumericT>
+std::vector<viennacl::matrix_range<viennacl::matrix<NumericT>>> band_views(
+    const viennacv::image_colpre<NumericT> & i_image, size_t row_begin, size_t row_end)
+{
+    std::vector<viennacl::matrix_range<viennacl::matrix<NumericT>>> t_views;
+    t_views.reserve(i_image.get_color_num());
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        t_views.emplace_back(const_cast<viennacl::matrix<NumericT> &>(i_image.data_[color]),
+                             viennacl::range(row_begin, row_end), viennacl::range(0, i_image.get_column_num()));
+    return t_views;
+}
+} //namespace viennacv::detail
+
+/** @brief A chain of filter stages (e.g. color conversion -> blur -> Sobel -> threshold) applied to a stream of same-sized frames on host memory.
+ *
+ * Every stage computes its output in bands of rows, and band b of stage s is computed as soon as stage s - 1 has produced bands b - 1, b and b + 1,
+ * which hold every row it reads, so the rows handed from stage to stage are still in cache. Bands are at least as tall as the largest halo.
+ * With VIENNACL_WITH_OPENMP every band of every stage of every frame is an OpenMP task depending on exactly these inputs, so the bands of a stage run
+ * in parallel and stage s of frame k overlaps with stage s - 1 of frame k + 1. Intermediate images are owned by the pipeline, one set per frame in
+ * flight, and reused by every call to process.
+ *
+ * A stage is a function computing the output rows [row_begin, row_end) of its output image from the whole input image, together with the number of
+ * output channels and its halo, the number of input rows above and below an output row it reads.
+ *
+ * @example
+ * viennacv::image_pipeline<float> pipeline;
+ * pipeline.add_format(viennacv::RGB, viennacv::Gray)
+ *         .add_separable(blur, blur)
+ *         .add_sobel_magnitude()
+ *         .add_threshold(0.5, 0, 1);
+ * pipeline.process(camera_frames, edge_frames);
+ */
+template <typename NumericT>
+class image_pipeline
+{
+public:
+    typedef std::function<void(const viennacv::image_colpre<NumericT> &, viennacv::image_colpre<NumericT> &, size_t, size_t)> stage_function;
+
+    // SECTION 01_001 Constructor
+    /** @brief image_pipeline constructor
+     * @param  {size_t} l_band_rows        : Rows of one band
+     * @param  {size_t} l_frames_in_flight : Number of frames processed concurrently, each one needs its own intermediate images
+     */
+    explicit image_pipeline(size_t l_band_rows = VIENNACV_PIPELINE_BAND_ROWS, size_t l_frames_in_flight = 2)
+        : band_rows_(std::max(l_band_rows, (size_t)1)), slot_num_(std::max(l_frames_in_flight, (size_t)1))
+    {
+    }
+
+    inline size_t get_stage_num() const { return stages_.size();};
+
+    // SECTION 01_002 Stages
+    /** @brief Append a user defined stage
+     * @param  {size_t} l_color_num     : Number of output channels, 0 to keep the number of input channels
+     * @param  {size_t} l_halo          : Input rows above and below an output row the stage reads
+     * @param  {stage_function} i_stage : Computes the output rows [row_begin, row_end), the output image already having the input size and its channels. Called concurrently for disjoint row ranges.
+     */
+    image_pipeline & add_stage(size_t l_color_num, size_t l_halo, stage_function i_stage)
+    {
+        stages_.push_back({l_color_num, l_halo, i_stage, false, RGB});
+        return *this;
+    }
+
+    /** @brief Append a color conversion, see format_transform. One of the formats must be RGB, Bayer mosaics are not supported as they are not band local. */
+    image_pipeline & add_format(image_format i_image_format, image_format o_image_format)
+    {
+        assert( !detail::is_bayer(i_image_format) && ((i_image_format == RGB) || (o_image_format == RGB))
+                && bool("Check failed in image_pipeline::add_format(): the conversion must be a single step from or to RGB!") );
+        add_stage(detail::format_color_num(o_image_format), 0,
+            [i_image_format, o_image_format](const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image, size_t row_begin, size_t row_end)
+            {
+                auto t_in_views = detail::band_views(i_image, row_begin, row_end);
+                auto t_out_views = detail::band_views(o_image, row_begin, row_end);
+                std::vector<const viennacl::matrix_base<NumericT> *> t_in;
+                std::vector<viennacl::matrix_base<NumericT> *> t_out;
+                for (auto & view: t_in_views)  t_in.push_back(&view);
+                for (auto & view: t_out_views) t_out.push_back(&view);
+                detail::color_transform(t_in, i_image_format, t_out, o_image_format);
+            });
+        stages_.back().sets_format = true;
+        stages_.back().format = o_image_format;
+        return *this;
+    }
+
+    /** @brief Append a 2D convolution of every channel with the origin at the kernel center, see convolve. */
+    image_pipeline & add_convolution(const viennacl::matrix<NumericT> & i_kernel)
+    {
+        return add_taps(detail::make_kernel_taps(i_kernel, std::vector<std::pair<size_t, size_t>>()));
+    }
+
+    /** @brief Append a separable convolution column_kernel * row_kernel^T of every channel as two stages, the row pass needing no halo. Integer pixels are rounded to the pixel type between the passes. */
+    template <typename TapT>
+    image_pipeline & add_separable(const std::vector<TapT> & i_column_kernel, const std::vector<TapT> & i_row_kernel)
+    {
+        add_taps(detail::make_1d_taps<Direction::X>(i_row_kernel));
+        return add_taps(detail::make_1d_taps<Direction::Y>(i_column_kernel));
+    }
+
+    /** @brief Append the Sobel gradient magnitude of every channel, see sobel_gradient. */
+    image_pipeline & add_sobel_magnitude()
+    {
+        return add_stage(0, 1,
+            [](const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image, size_t row_begin, size_t row_end)
+            {
+                for (size_t color = 0; color < i_image.get_color_num(); color++)
+                    viennacl::linalg::host_based::sobel_gradient<NumericT, NumericT>(i_image.data_[color], NULL, NULL, &o_image.data_[color], NULL, 0, row_begin, row_end);
+            });
+    }
+
+    /** @brief Append a binary threshold of every channel, (pixel > threshold) ? high : low. */
+    image_pipeline & add_threshold(NumericT threshold, NumericT low, NumericT high)
+    {
+        return add_stage(0, 0,
+            [threshold, low, high](const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image, size_t row_begin, size_t row_end)
+            {
+                auto t_in_views = detail::band_views(i_image, row_begin, row_end);
+                auto t_out_views = detail::band_views(o_image, row_begin, row_end);
+                for (size_t color = 0; color < t_in_views.size(); color++)
+                    viennacl::linalg::host_based::threshold(t_in_views[color], threshold, low, high, t_out_views[color]);
+            });
+    }
+
+    // SECTION 01_003 Execution
+    /** @brief Run the pipeline on a sequence of frames, e.g. the frames grabbed from a camera since the last call.
+     * @param  {std::vector<viennacv::image_colpre<NumericT>>} i_frames : Input frames of the same size on host memory
+     * @param  {std::vector<viennacv::image_colpre<NumericT>>} o_frames : Output frames, resized if necessary. Must not be the input frames.
+     */
+    void process(const std::vector<viennacv::image_colpre<NumericT>> & i_frames, std::vector<viennacv::image_colpre<NumericT>> & o_frames)
+    {
+        if (o_frames.size() > i_frames.size()) o_frames.erase(o_frames.begin() + i_frames.size(), o_frames.end());
+        while (o_frames.size() < i_frames.size()) o_frames.emplace_back(std::vector<viennacl::matrix<NumericT>>());
+        std::vector<const viennacv::image_colpre<NumericT> *> t_in;
+        std::vector<viennacv::image_colpre<NumericT> *> t_out;
+        for (auto & frame: i_frames) t_in.push_back(&frame);
+        for (auto & frame: o_frames) t_out.push_back(&frame);
+        process(t_in, t_out);
+    }
+
+    /** @brief Run the pipeline on a single frame, the bands of every stage running in parallel. */
+    void process(const viennacv::image_colpre<NumericT> & i_frame, viennacv::image_colpre<NumericT> & o_frame)
+    {
+        std::vector<const viennacv::image_colpre<NumericT> *> t_in(1, &i_frame);
+        std::vector<viennacv::image_colpre<NumericT> *> t_out(1, &o_frame);
+        process(t_in, t_out);
+    }
+
+protected:
+    struct stage_type
+    {
+        size_t          color_num;      // 0 keeps the number of input channels
+        size_t          halo;
+        stage_function  run;
+        bool            sets_format;    // The output format is 'format' instead of the input format
+        image_format    format;
+    };
+
+    image_pipeline & add_taps(const std::vector<viennacl::linalg::host_based::detail::convolution_tap<double>> & i_taps)
+    {
+        long l_halo = 0;
+        for (auto & tap: i_taps)
+            l_halo = std::max(l_halo, std::abs(tap.row_bias));
+        detail::host_taps<NumericT> t_taps = detail::make_host_taps<NumericT>(i_taps);
+        return add_stage(0, (size_t)l_halo,
+            [t_taps](const viennacv::image_colpre<NumericT> & i_image, viennacv::image_colpre<NumericT> & o_image, size_t row_begin, size_t row_end)
+            {
+                for (size_t color = 0; color < i_image.get_color_num(); color++)
+                    detail::run_host_taps<NumericT>(i_image.data_[color], t_taps, o_image.data_[color], 0, row_begin, row_end);
+            });
+    }
+
+    void process(const std::vector<const viennacv::image_colpre<NumericT> *> & i_frames, const std::vector<viennacv::image_colpre<NumericT> *> & o_frames)
+    {
+        if (i_frames.empty() || stages_.empty()) return;
+        prepare(i_frames, o_frames);
+        size_t l_frame_num = i_frames.size(),
+               l_row_num = i_frames[0]->get_row_num(),
+               l_band_rows = band_rows_,
+               l_stage_num = stages_.size();
+        for (auto & stage: stages_)
+            l_band_rows = std::max(l_band_rows, stage.halo);
+        size_t l_band_num = (l_row_num + l_band_rows - 1) / l_band_rows;
+
+        // NOTE A stage with a halo runs one band behind the stage before it, which then has finished the band below.
+        std::vector<size_t> t_lag(l_stage_num, 0);
+        for (size_t stage = 1; stage < l_stage_num; stage++)
+            t_lag[stage] = t_lag[stage - 1] + (stages_[stage].halo ? 1 : 0);
+
+        // NOTE One dependency token per band task, the last entry is a token nothing writes, standing for the dependencies outside the frame.
+        std::vector<char> t_tokens(l_frame_num * l_stage_num * l_band_num + 1, 0);
+        char * t_none = &t_tokens.back();
+        auto token = [&](size_t frame, long band, size_t stage) -> char *
+        {
+            if ((band < 0) || (band >= (long)l_band_num)) return t_none;
+            return &t_tokens[(frame * l_stage_num + stage) * l_band_num + band];
+        };
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel
+        #pragma omp single
+#endif
+        for (size_t frame = 0; frame < l_frame_num; frame++)
+        for (size_t step = 0; step < l_band_num + t_lag.back(); step++)
+        for (size_t stage = 0; stage < l_stage_num; stage++)
+        {
+            if ((step < t_lag[stage]) || (step - t_lag[stage] >= l_band_num)) continue;
+            long band = (long)(step - t_lag[stage]);
+            // Bands of the previous stage holding the input rows, and the readers of this slot's buffer in the frame 'slot_num_' frames before.
+            // NOTE A stage without halo only reads its own band, so it does not wait for the neighbouring bands, which would serialize the bands.
+            bool l_input = (stage > 0),
+                 l_reuse = (frame >= slot_num_) && (stage + 1 < l_stage_num),
+                 l_input_halo = l_input && (stages_[stage].halo > 0),
+                 l_reuse_halo = l_reuse && (stages_[stage + 1].halo > 0);
+            char * t_in0 = l_input_halo ? token(frame, band - 1, stage - 1) : t_none;
+            char * t_in1 = l_input ? token(frame, band, stage - 1) : t_none;
+            char * t_in2 = l_input_halo ? token(frame, band + 1, stage - 1) : t_none;
+            char * t_reuse0 = l_reuse_halo ? token(frame - slot_num_, band - 1, stage + 1) : t_none;
+            char * t_reuse1 = l_reuse ? token(frame - slot_num_, band, stage + 1) : t_none;
+            char * t_reuse2 = l_reuse_halo ? token(frame - slot_num_, band + 1, stage + 1) : t_none;
+            char * t_self = token(frame, band, stage);
+            size_t l_row_begin = (size_t)band * l_band_rows,
+                   l_row_end = std::min(l_row_begin + l_band_rows, l_row_num);
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp task firstprivate(frame, stage, l_row_begin, l_row_end) depend(in: t_in0[0], t_in1[0], t_in2[0], t_reuse0[0], t_reuse1[0], t_reuse2[0]) depend(out: t_self[0])
+#endif
+            {
+                std::vector<viennacv::image_colpre<NumericT>> & t_slot = buffers_[frame % slot_num_];
+                const viennacv::image_colpre<NumericT> & t_in = (stage == 0) ? *i_frames[frame] : t_slot[stage - 1];
+                viennacv::image_colpre<NumericT> & t_out = (stage + 1 == l_stage_num) ? *o_frames[frame] : t_slot[stage];
+                stages_[stage].run(t_in, t_out, l_row_begin, l_row_end);
+            }
+            (void)t_in0; (void)t_in1; (void)t_in2; (void)t_reuse0; (void)t_reuse1; (void)t_reuse2; (void)t_self;
+        }
+    }
+
+    /** @brief Size the intermediate images of every frame slot and the output frames, keeping their memory if the sizes did not change */
+    void prepare(const std::vector<const viennacv::image_colpre<NumericT> *> & i_frames, const std::vector<viennacv::image_colpre<NumericT> *> & o_frames)
+    {
+        size_t l_row_num = i_frames[0]->get_row_num(),
+               l_column_num = i_frames[0]->get_column_num(),
+               l_color_num = i_frames[0]->get_color_num();
+        image_format l_image_format = i_frames[0]->image_format_;
+        std::vector<size_t> t_color_num(stages_.size());
+        std::vector<image_format> t_format(stages_.size());
+        for (size_t stage = 0; stage < stages_.size(); stage++)
+        {
+            l_color_num = stages_[stage].color_num ? stages_[stage].color_num : l_color_num;
+            l_image_format = stages_[stage].sets_format ? stages_[stage].format : l_image_format;
+            t_color_num[stage] = l_color_num;
+            t_format[stage] = l_image_format;
+        }
+        auto shape = [&](viennacv::image_colpre<NumericT> & o_image, size_t stage)
+        {
+            o_image.data_.resize(t_color_num[stage]);
+            o_image.image_format_ = t_format[stage];
+            for (auto & channel: o_image.data_)
+                if ((channel.size1() != l_row_num) || (channel.size2() != l_column_num))
+                    channel.resize(l_row_num, l_column_num, false);
+        };
+
+        buffers_.resize(slot_num_);
+        for (auto & t_slot: buffers_)
+        {
+            if (t_slot.size() > stages_.size()) t_slot.erase(t_slot.begin() + stages_.size(), t_slot.end());
+            while (t_slot.size() < stages_.size()) t_slot.emplace_back(std::vector<viennacl::matrix<NumericT>>());
+            for (size_t stage = 0; stage + 1 < stages_.size(); stage++)
+                shape(t_slot[stage], stage);
+        }
+        for (size_t frame = 0; frame < i_frames.size(); frame++)
+        {
+            assert( (i_frames[frame]->get_row_num() == l_row_num) && (i_frames[frame]->get_column_num() == l_column_num)
+                    && (viennacl::traits::active_handle_id(i_frames[frame]->data_[0]) == viennacl::MAIN_MEMORY)
+                    && bool("Check failed in image_pipeline::process(): the frames must have the same size and live in host memory!") );
+            shape(*o_frames[frame], stages_.size() - 1);
+        }
+    }
+
+    std::vector<stage_type>                                     stages_;
+    std::vector<std::vector<viennacv::image_colpre<NumericT>>>  buffers_;   // Intermediate images, [frame slot][stage]
+    size_t band_rows_;
+    size_t slot_num_;
+}; //class viennacv::image_pipeline
+
+
+} //namespace viennacv
@@ -0,0 +1,234 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_pyramid.hpp
+    @brief Implementation of Gaussian and Laplacian image pyramids with a fused blur-and-decimate step
+*/
+
+#include <vector>
+#include <type_traits>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Pyramid steps
+namespace viennacv
+{
+
+namespace detail
+{
+template <typename MatrixT>
+void check_host_memory(const MatrixT & i_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+}
+} //namespace viennacv::detail
+
+/** @brief One pyramid level down, blur by the 5 x 5 binomial kernel and drop every second row and column, computing only the retained pixels. Host memory only.
+ *
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image of size ((rows + 1) / 2) x ((columns + 1) / 2), resized if necessary. Must not be the input image.
+ */
+template <typename NumericT>
+void pyramid_down(
+    const viennacv::image_colpre<NumericT> & i_image,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    size_t l_row_num = (i_image.get_row_num() + 1) / 2,
+           l_column_num = (i_image.get_column_num() + 1) / 2;
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        detail::check_host_memory(i_image.data_[color]);
+        if ((o_image.data_[color].size1() != l_row_num) || (o_image.data_[color].size2() != l_column_num))
+            o_image.data_[color].resize(l_row_num, l_column_num, false);
+        viennacl::linalg::host_based::pyramid_down(i_image.data_[color], o_image.data_[color]);
+    }
+}
+
+/** @brief One pyramid level up, insert zeros between the pixels and blur by 4 times the 5 x 5 binomial kernel. Host memory only.
+ *
+ * @param  {viennacv::image_colpre<NumericT>} i_image : Input image
+ * @param  {viennacv::image_colpre<NumericT>} o_image : Output image, resized to twice the input size unless it already has 2 * size - 1 rows or columns. Must not be the input image.
+ */
+template <typename NumericT>
+void pyramid_up(
+    const viennacv::image_colpre<NumericT> & i_image,
+    viennacv::image_colpre<NumericT> & o_image)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+    {
+        detail::check_host_memory(i_image.data_[color]);
+        viennacl::matrix<NumericT> & o_matrix = o_image.data_[color];
+        // NOTE An odd sized finer level, e.g. 2 * rows - 1, is kept so that pyramid_up inverts the size change of pyramid_down.
+        if (((o_matrix.size1() + 1) / 2 != i_image.get_row_num()) || ((o_matrix.size2() + 1) / 2 != i_image.get_column_num()))
+            o_matrix.resize(2 * i_image.get_row_num(), 2 * i_image.get_column_num(), false);
+        viennacl::linalg::host_based::pyramid_up(i_image.data_[color], o_matrix);
+    }
+}
+
+
+// SECTION 02 Declare the image pyramid class
+/** @brief Gaussian or Laplacian pyramid of a viennacv::image_colpre.
+ *
+ * All levels of all color channels live in one arena matrix, the channels stacked as blocks of rows and the levels of a channel stacked inside its block,
+ * so building the pyramid of the next frame of the same size allocates nothing. Every level is exposed without copying as a viennacl::matrix_range of the arena.
+ * Each level is computed from the previous one by the fused blur-and-decimate pyramid_down, which only computes the retained pixels, parallel over the rows.
+ *
+ * @example
+ * viennacv::image_pyramid<float> pyramid;
+ * pyramid.build_laplacian(vcl_image, 4);
+ * // ... modify the levels through pyramid.level(l, color) ...
+ * pyramid.collapse(vcl_result);
+ */
+template <typename NumericT>
+class image_pyramid
+{
+public:
+    typedef viennacl::matrix_range<viennacl::matrix<NumericT>>  level_type;
+
+    viennacl::matrix<NumericT> arena_;    /** @brief The shared storage of all levels */
+    image_format image_format_ = RGB;
+protected:
+    size_t color_num_ = 0;
+    size_t arena_row_num_ = 0;                      // Rows of one channel block
+    std::vector<size_t> row_offsets_, row_nums_, column_nums_;
+    bool laplacian_ = false;
+public:
+    inline size_t get_level_num()  const { return row_nums_.size();};
+    inline size_t get_color_num()  const { return color_num_;};
+    inline size_t get_row_num(size_t level)    const { return row_nums_[level];};
+    inline size_t get_column_num(size_t level) const { return column_nums_[level];};
+    inline bool   is_laplacian()   const { return laplacian_;};
+
+    // SECTION 02_001 Level access
+    /** @brief One color channel of one level as a view into the arena */
+    level_type level(size_t l_level, size_t color) const
+    {
+        size_t l_begin = color * arena_row_num_ + row_offsets_[l_level];
+        return level_type(const_cast<viennacl::matrix<NumericT> &>(arena_),
+                          viennacl::range(l_begin, l_begin + row_nums_[l_level]),
+                          viennacl::range(0, column_nums_[l_level]));
+    }
+
+    /** @brief Copy one level out to an image */
+    void get_level(size_t l_level, viennacv::image_colpre<NumericT> & o_image) const
+    {
+        o_image.data_.resize(color_num_);
+        o_image.image_format_ = image_format_;
+        for (size_t color = 0; color < color_num_; color++)
+        {
+            if ((o_image.data_[color].size1() != row_nums_[l_level]) || (o_image.data_[color].size2() != column_nums_[l_level]))
+                o_image.data_[color].resize(row_nums_[l_level], column_nums_[l_level], false);
+            o_image.data_[color] = level(l_level, color);
+        }
+    }
+
+    // SECTION 02_002 Pyramid construction
+    /** @brief Build the Gaussian pyramid, level 0 being a copy of the image and level l + 1 pyramid_down of level l.
+     * @param  {viennacv::image_colpre<NumericT>} i_image : Input image on host memory
+     * @param  {size_t} l_level_num                       : Number of levels including level 0, limited to the levels of at least one pixel
+     */
+    void build_gaussian(const viennacv::image_colpre<NumericT> & i_image, size_t l_level_num)
+    {
+        layout(i_image, l_level_num);
+        for (size_t color = 0; color < color_num_; color++)
+        {
+            detail::check_host_memory(i_image.data_[color]);
+            level_type t_level0 = level(0, color);
+            t_level0 = i_image.data_[color];
+            for (size_t l = 1; l < get_level_num(); l++)
+            {
+                level_type t_coarse = level(l, color);
+                viennacl::linalg::host_based::pyramid_down(level(l - 1, color), t_coarse);
+            }
+        }
+        laplacian_ = false;
+    }
+
+    /** @brief Build the Laplacian pyramid, level l being Gaussian level l minus pyramid_up of Gaussian level l + 1, and the last level the last Gaussian level. NumericT should be signed, unsigned levels saturate at 0.
+     * @param  {viennacv::image_colpre<NumericT>} i_image : Input image on host memory
+     * @param  {size_t} l_level_num                       : Number of levels, see build_gaussian
+     */
+    void build_laplacian(const viennacv::image_colpre<NumericT> & i_image, size_t l_level_num)
+    {
+        build_gaussian(i_image, l_level_num);
+        // NOTE Going from fine to coarse, Gaussian level l + 1 is still intact when level l is turned into a difference.
+        for (size_t color = 0; color < color_num_; color++)
+        for (size_t l = 0; l + 1 < get_level_num(); l++)
+        {
+            level_type t_fine = level(l, color);
+            viennacl::linalg::host_based::pyramid_up(level(l + 1, color), t_fine, -1);
+        }
+        laplacian_ = true;
+    }
+
+    /** @brief Turn a Laplacian pyramid back into the Gaussian one in place and copy level 0 to the output image, which then equals the input of build_laplacian up to rounding.
+     * @param  {viennacv::image_colpre<NumericT>} o_image : Output image
+     */
+    void collapse(viennacv::image_colpre<NumericT> & o_image)
+    {
+        if (laplacian_)
+        {
+            for (size_t color = 0; color < color_num_; color++)
+            for (size_t l = get_level_num() - 1; l > 0; l--)
+            {
+                level_type t_fine = level(l - 1, color);
+                viennacl::linalg::host_based::pyramid_up(level(l, color), t_fine, 1);
+            }
+            laplacian_ = false;
+        }
+        get_level(0, o_image);
+    }
+
+protected:
+    /** @brief Compute the level sizes and size the arena, keeping its memory if the layout did not change */
+    void layout(const viennacv::image_colpre<NumericT> & i_image, size_t l_level_num)
+    {
+        color_num_ = i_image.get_color_num();
+        image_format_ = i_image.image_format_;
+        row_offsets_.clear(); row_nums_.clear(); column_nums_.clear();
+        size_t l_row_num = i_image.get_row_num(),
+               l_column_num = i_image.get_column_num(),
+               l_offset = 0;
+        for (size_t l = 0; l < l_level_num; l++)
+        {
+            row_offsets_.push_back(l_offset);
+            row_nums_.push_back(l_row_num);
+            column_nums_.push_back(l_column_num);
+            l_offset += l_row_num;
+            if ((l_row_num == 1) && (l_column_num == 1)) break;
+            l_row_num = (l_row_num + 1) / 2;
+            l_column_num = (l_column_num + 1) / 2;
+        }
+        arena_row_num_ = l_offset;
+        if ((arena_.size1() != color_num_ * arena_row_num_) || (arena_.size2() != i_image.get_column_num()))
+            arena_.resize(color_num_ * arena_row_num_, i_image.get_column_num(), false);
+    }
+}; //class viennacv::image_pyramid
+
+
+} //namespace viennacv
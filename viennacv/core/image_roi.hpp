@@ -0,0 +1,188 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_roi.hpp
+    @brief Implementation of region of interest views over viennacv::image_colpre, sharing the pixel memory of the image
+*/
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Declare the image view class
+namespace viennacv
+{
+
+/** @brief A rectangle of an image, optionally subsampled, whose channels are viennacl::matrix_slice views of the image channels. No pixel is copied:
+ *  writing to a view writes to the image, which must outlive the view.
+ *
+ * Views are passed to convolution_filter::apply like images. Copies of a view are views of the same pixels; assigning one view to another is not
+ * allowed, use assign or copy_to to move pixels.
+ *
+ * @tparam NumericT : Pixel type
+ *
+ * @example
+ * viennacv::image_view<float> crop(frame, {120, 200, 64, 64}), blurred_crop(blurred, {120, 200, 64, 64});
+ * blur.apply(crop, blurred_crop);                                         // the crop is filtered as an image of its own
+ * viennacv::image_view<float> half(frame, {0, 0, frame.get_row_num() / 2, frame.get_column_num() / 2}, 2, 2);   // every other pixel
+ */
+template <typename NumericT>
+class image_view
+{
+public:
+    typedef viennacl::matrix_slice<viennacl::matrix<NumericT>>  channel_type;
+
+    // SECTION 01_001 Constructor
+    /** @brief View of a rectangle of an image
+     * @param  {image_colpre<NumericT>} i_image : Viewed image
+     * @param  {image_rect} rect                : First pixel of the view in the image, and size of the view
+     * @param  {size_t} l_row_step              : Distance between two rows of the view, in rows of the image
+     * @param  {size_t} l_column_step           : Distance between two columns of the view, in columns of the image
+     */
+    image_view(viennacv::image_colpre<NumericT> & i_image, const image_rect & rect, size_t l_row_step = 1, size_t l_column_step = 1)
+        : image_format_(i_image.image_format_)
+    {
+        assert( (i_image.get_color_num() > 0) && bool("Check failed in image_view(): the image has no channel!") );
+        check_rect(rect, l_row_step, l_column_step, i_image.get_row_num(), i_image.get_column_num());
+        channels_.reserve(i_image.get_color_num());
+        for (size_t color = 0; color < i_image.get_color_num(); color++)
+            channels_.push_back(channel_type(i_image.data_[color], viennacl::slice(rect.top, l_row_step, rect.rows),
+                                                                   viennacl::slice(rect.left, l_column_step, rect.columns)));
+    }
+
+    /** @brief View of the whole image */
+    explicit image_view(viennacv::image_colpre<NumericT> & i_image)
+        : image_view(i_image, image_rect{0, 0, i_image.get_row_num(), i_image.get_column_num()})
+    {
+    }
+
+    /** @brief View of a rectangle of another view, in pixels of that view */
+    image_view(const image_view & i_view, const image_rect & rect, size_t l_row_step = 1, size_t l_column_step = 1)
+        : image_format_(i_view.image_format_)
+    {
+        check_rect(rect, l_row_step, l_column_step, i_view.get_row_num(), i_view.get_column_num());
+        channels_.reserve(i_view.get_color_num());
+        for (size_t color = 0; color < i_view.get_color_num(); color++)
+            channels_.push_back(channel_type(i_view.channels_[color], viennacl::slice(rect.top, l_row_step, rect.rows),
+                                                                      viennacl::slice(rect.left, l_column_step, rect.columns)));
+    }
+
+    image_view(const image_view & i_view) = default;
+    image_view(image_view && i_view) = default;
+    // NOTE Assigning a matrix_slice copies pixels, so view assignment would silently copy instead of rebinding.
+    image_view & operator=(const image_view & i_view) = delete;
+
+    // SECTION 01_002 Access
+    inline size_t get_color_num()  const { return channels_.size(); }
+    inline size_t get_row_num()    const { return channels_.empty() ? 0 : channels_[0].size1(); }
+    inline size_t get_column_num() const { return channels_.empty() ? 0 : channels_[0].size2(); }
+    inline image_format get_format() const { return image_format_; }
+
+    /** @brief View of one channel, usable wherever a viennacl::matrix_base is */
+    channel_type & channel(size_t color)
+    {
+        assert( (color < channels_.size()) && bool("Check failed in image_view::channel(): no such channel!") );
+        return channels_[color];
+    }
+
+    const channel_type & channel(size_t color) const
+    {
+        assert( (color < channels_.size()) && bool("Check failed in image_view::channel(): no such channel!") );
+        return channels_[color];
+    }
+
+    // SECTION 01_003 Pixel transfer
+    /** @brief Copy the viewed pixels into an image of the view size, e.g. to keep a crop after the viewed image changes
+     * @param  {image_colpre<NumericT>} o_image : Output image, resized if necessary
+     */
+    void copy_to(viennacv::image_colpre<NumericT> & o_image) const
+    {
+        o_image.data_.resize(get_color_num());
+        o_image.image_format_ = image_format_;
+        for (size_t color = 0; color < get_color_num(); color++)
+        {
+            if ((o_image.data_[color].size1() != get_row_num()) || (o_image.data_[color].size2() != get_column_num()))
+                o_image.data_[color].resize(get_row_num(), get_column_num(), false);
+            o_image.data_[color] = channels_[color];
+        }
+    }
+
+    /** @brief Overwrite the viewed pixels with an image of the view size, e.g. to paste a processed crop back */
+    void assign(const viennacv::image_colpre<NumericT> & i_image)
+    {
+        assert( (i_image.get_color_num() == get_color_num()) && (i_image.get_row_num() == get_row_num()) && (i_image.get_column_num() == get_column_num())
+                && bool("Check failed in image_view::assign(): the image does not have the view size!") );
+        for (size_t color = 0; color < get_color_num(); color++)
+            channels_[color] = i_image.data_[color];
+    }
+
+protected:
+    static void check_rect(const image_rect & rect, size_t l_row_step, size_t l_column_step, size_t l_row_num, size_t l_column_num)
+    {
+        assert( (l_row_step > 0) && (l_column_step > 0) && bool("Check failed in image_view(): zero step!") );
+        assert( ((rect.rows == 0) || (rect.top + (rect.rows - 1) * l_row_step < l_row_num))
+                && ((rect.columns == 0) || (rect.left + (rect.columns - 1) * l_column_step < l_column_num))
+                && bool("Check failed in image_view(): the rectangle exceeds the image!") );
+        (void)rect; (void)l_row_step; (void)l_column_step; (void)l_row_num; (void)l_column_num;
+    }
+
+    std::vector<channel_type>   channels_;
+    image_format                image_format_;
+}; //class viennacv::image_view
+
+
+// SECTION 02 Tiling
+/** @brief Rectangles of the tiles of split_tiles, e.g. to filter the tiles of a full image region by region, see split_tiles */
+inline std::vector<image_rect> tile_rects(size_t l_row_num, size_t l_column_num, size_t l_tile_rows, size_t l_tile_columns)
+{
+    assert( (l_tile_rows > 0) && (l_tile_columns > 0) && bool("Check failed in tile_rects(): empty tiles!") );
+    std::vector<image_rect> t_rects;
+    for (size_t top = 0; top < l_row_num; top += l_tile_rows)
+        for (size_t left = 0; left < l_column_num; left += l_tile_columns)
+            t_rects.push_back(image_rect{top, left, std::min(l_tile_rows, l_row_num - top), std::min(l_tile_columns, l_column_num - left)});
+    return t_rects;
+}
+
+/** @brief Cut an image into disjoint views of at most l_tile_rows x l_tile_columns pixels, row by row, the last row and column of tiles being smaller
+ *  if the image size is not a multiple of the tile size. Tiles do not share pixels, so different threads may write to different tiles.
+ *
+ * Filtering a tile treats it as an image of its own; to get the tile of a filtered full image instead, filter the tile rectangle with
+ * convolution_filter::apply(image, image_rect, image).
+ *
+ * @param  {image_colpre<NumericT>} i_image : Viewed image
+ * @param  {size_t} l_tile_rows             : Tile height
+ * @param  {size_t} l_tile_columns          : Tile width
+ * @return {std::vector<image_view<NumericT>>} : Views of the tiles
+ */
+template <typename NumericT>
+std::vector<image_view<NumericT>> split_tiles(viennacv::image_colpre<NumericT> & i_image, size_t l_tile_rows, size_t l_tile_columns)
+{
+    std::vector<image_view<NumericT>> t_tiles;
+    for (auto & rect: tile_rects(i_image.get_row_num(), i_image.get_column_num(), l_tile_rows, l_tile_columns))
+        t_tiles.push_back(image_view<NumericT>(i_image, rect));
+    return t_tiles;
+}
+
+
+} //namespace viennacv
@@ -0,0 +1,232 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/core/image_warp.hpp
+    @brief Implementation of geometric transformations: resize, affine and perspective warps and remapping by precomputed maps
+*/
+
+#include <vector>
+#include <cassert>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/warp_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Geometric transformations
+namespace viennacv
+{
+
+namespace detail
+{
+template <typename NumericT>
+void prepare_warp(const viennacl::matrix<NumericT> & i_matrix, size_t l_row_num, size_t l_column_num, viennacl::matrix<NumericT> & o_matrix)
+{
+    if (viennacl::traits::active_handle_id(i_matrix) != viennacl::MAIN_MEMORY)
+        throw viennacl::memory_exception("not implemented");
+    assert( (&i_matrix != &o_matrix) && bool("Check failed in warp: the output must not be the input!") );
+    if ((o_matrix.size1() != l_row_num) || (o_matrix.size2() != l_column_num))
+        o_matrix.resize(l_row_num, l_column_num, false);
+}
+
+/** @brief Inverse of a row-major 2 x 3 affine map (the last row being 0 0 1) or 3 x 3 homography */
+inline std::vector<double> invert_transform(const std::vector<double> & i_transform)
+{
+    std::vector<double> m(i_transform);
+    if (m.size() == 6)
+        m.insert(m.end(), {0.0, 0.0, 1.0});
+    assert( (m.size() == 9) && bool("Check failed in invert_transform(): a transform has 6 or 9 entries!") );
+    double det = m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    assert( (det != 0) && bool("Check failed in invert_transform(): the transform is singular!") );
+    std::vector<double> t_inverse = {
+        (m[4] * m[8] - m[5] * m[7]) / det, (m[2] * m[7] - m[1] * m[8]) / det, (m[1] * m[5] - m[2] * m[4]) / det,
+        (m[5] * m[6] - m[3] * m[8]) / det, (m[0] * m[8] - m[2] * m[6]) / det, (m[2] * m[3] - m[0] * m[5]) / det,
+        (m[3] * m[7] - m[4] * m[6]) / det, (m[1] * m[6] - m[0] * m[7]) / det, (m[0] * m[4] - m[1] * m[3]) / det };
+    if (i_transform.size() == 6)
+        t_inverse.resize(6);
+    return t_inverse;
+}
+} //namespace viennacv::detail
+
+// SECTION 01_001 Resize
+/** @brief Resize a matrix, the pixel centers being aligned and the border replicated. Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {size_t} l_row_num                    : Output rows
+ * @param  {size_t} l_column_num                 : Output columns
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. Must not be i_matrix.
+ * @param  {viennacv::interpolation} method      : NEAREST, BILINEAR, BICUBIC or AREA (box average when shrinking)
+ */
+template <typename NumericT>
+void resize(
+    const viennacl::matrix<NumericT> & i_matrix,
+    size_t l_row_num, size_t l_column_num,
+    viennacl::matrix<NumericT> & o_matrix,
+    interpolation method = BILINEAR)
+{
+    detail::prepare_warp(i_matrix, l_row_num, l_column_num, o_matrix);
+    viennacl::linalg::host_based::resize(i_matrix, method, o_matrix);
+}
+
+/** @brief Channel-wise resize for viennacv::image_colpre, see the viennacl::matrix version. */
+template <typename NumericT>
+void resize(
+    const viennacv::image_colpre<NumericT> & i_image,
+    size_t l_row_num, size_t l_column_num,
+    viennacv::image_colpre<NumericT> & o_image,
+    interpolation method = BILINEAR)
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        resize<NumericT>(i_image.data_[color], l_row_num, l_column_num, o_image.data_[color], method);
+}
+
+// SECTION 01_002 Affine warp
+/** @brief Warp a matrix by an affine transform, a pixel at (x, y) = (column, row) of the input moving to (t[0] x + t[1] y + t[2], t[3] x + t[4] y + t[5]) of the output. Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {std::vector<double>} i_transform     : Row-major 2 x 3 transform
+ * @param  {size_t} l_row_num                    : Output rows
+ * @param  {size_t} l_column_num                 : Output columns
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. Must not be i_matrix.
+ * @param  {viennacv::interpolation} method      : NEAREST, BILINEAR or BICUBIC. AREA is sampled as BILINEAR, a pointwise map having no box to average.
+ * @param  {NumericT} border                     : Value of the output pixels mapped outside of the input
+ * @param  {bool} inverse_map                    : i_transform already maps output to input positions
+ */
+template <typename NumericT>
+void warp_affine(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const std::vector<double> & i_transform,
+    size_t l_row_num, size_t l_column_num,
+    viennacl::matrix<NumericT> & o_matrix,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0),
+    bool inverse_map = false)
+{
+    assert( (i_transform.size() == 6) && bool("Check failed in warp_affine(): the transform must be 2 x 3!") );
+    detail::prepare_warp(i_matrix, l_row_num, l_column_num, o_matrix);
+    viennacl::linalg::host_based::warp_affine(i_matrix, inverse_map ? i_transform : detail::invert_transform(i_transform), method, border, o_matrix);
+}
+
+/** @brief Channel-wise affine warp for viennacv::image_colpre, see the viennacl::matrix version. */
+template <typename NumericT>
+void warp_affine(
+    const viennacv::image_colpre<NumericT> & i_image,
+    const std::vector<double> & i_transform,
+    size_t l_row_num, size_t l_column_num,
+    viennacv::image_colpre<NumericT> & o_image,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0),
+    bool inverse_map = false)
+{
+    std::vector<double> t_inverse = inverse_map ? i_transform : detail::invert_transform(i_transform);
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        warp_affine<NumericT>(i_image.data_[color], t_inverse, l_row_num, l_column_num, o_image.data_[color], method, border, true);
+}
+
+// SECTION 01_003 Perspective warp
+/** @brief Warp a matrix by a homography, a pixel at (x, y) of the input moving to ((h[0] x + h[1] y + h[2]) / w, (h[3] x + h[4] y + h[5]) / w), w = h[6] x + h[7] y + h[8]. Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {std::vector<double>} i_transform     : Row-major 3 x 3 homography
+ * @param  {size_t} l_row_num                    : Output rows
+ * @param  {size_t} l_column_num                 : Output columns
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. Must not be i_matrix.
+ * @param  {viennacv::interpolation} method      : NEAREST, BILINEAR or BICUBIC. AREA is sampled as BILINEAR, a pointwise map having no box to average.
+ * @param  {NumericT} border                     : Value of the output pixels mapped outside of the input
+ * @param  {bool} inverse_map                    : i_transform already maps output to input positions
+ */
+template <typename NumericT>
+void warp_perspective(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const std::vector<double> & i_transform,
+    size_t l_row_num, size_t l_column_num,
+    viennacl::matrix<NumericT> & o_matrix,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0),
+    bool inverse_map = false)
+{
+    assert( (i_transform.size() == 9) && bool("Check failed in warp_perspective(): the transform must be 3 x 3!") );
+    detail::prepare_warp(i_matrix, l_row_num, l_column_num, o_matrix);
+    viennacl::linalg::host_based::warp_perspective(i_matrix, inverse_map ? i_transform : detail::invert_transform(i_transform), method, border, o_matrix);
+}
+
+/** @brief Channel-wise perspective warp for viennacv::image_colpre, see the viennacl::matrix version. */
+template <typename NumericT>
+void warp_perspective(
+    const viennacv::image_colpre<NumericT> & i_image,
+    const std::vector<double> & i_transform,
+    size_t l_row_num, size_t l_column_num,
+    viennacv::image_colpre<NumericT> & o_image,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0),
+    bool inverse_map = false)
+{
+    std::vector<double> t_inverse = inverse_map ? i_transform : detail::invert_transform(i_transform);
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        warp_perspective<NumericT>(i_image.data_[color], t_inverse, l_row_num, l_column_num, o_image.data_[color], method, border, true);
+}
+
+// SECTION 01_004 Remap by precomputed maps
+/** @brief o_matrix(r, c) = i_matrix(map_y(r, c), map_x(r, c)), the output having the size of the maps. A map computed once, e.g. for lens undistortion, is applied to every frame without recomputing any coordinate. Host memory only.
+ *
+ * @param  {viennacl::matrix<NumericT>} i_matrix : Input matrix
+ * @param  {viennacl::matrix<MapT>} map_x        : Source column of every output pixel
+ * @param  {viennacl::matrix<MapT>} map_y        : Source row of every output pixel
+ * @param  {viennacl::matrix<NumericT>} o_matrix : Output matrix, resized if necessary. Must not be i_matrix.
+ * @param  {viennacv::interpolation} method      : NEAREST, BILINEAR or BICUBIC. AREA is sampled as BILINEAR, a pointwise map having no box to average.
+ * @param  {NumericT} border                     : Value of the output pixels mapped outside of the input
+ */
+template <typename NumericT, typename MapT>
+void remap(
+    const viennacl::matrix<NumericT> & i_matrix,
+    const viennacl::matrix<MapT> & map_x,
+    const viennacl::matrix<MapT> & map_y,
+    viennacl::matrix<NumericT> & o_matrix,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0))
+{
+    assert( (map_x.size1() == map_y.size1()) && (map_x.size2() == map_y.size2()) && bool("Check failed in remap(): the maps must have the same size!") );
+    detail::prepare_warp(i_matrix, map_x.size1(), map_x.size2(), o_matrix);
+    viennacl::linalg::host_based::remap(i_matrix, map_x, map_y, method, border, o_matrix);
+}
+
+/** @brief Channel-wise remap for viennacv::image_colpre, see the viennacl::matrix version. */
+template <typename NumericT, typename MapT>
+void remap(
+    const viennacv::image_colpre<NumericT> & i_image,
+    const viennacl::matrix<MapT> & map_x,
+    const viennacl::matrix<MapT> & map_y,
+    viennacv::image_colpre<NumericT> & o_image,
+    interpolation method = BILINEAR,
+    NumericT border = NumericT(0))
+{
+    o_image.data_.resize(i_image.get_color_num());
+    o_image.image_format_ = i_image.image_format_;
+    for (size_t color = 0; color < i_image.get_color_num(); color++)
+        remap<NumericT, MapT>(i_image.data_[color], map_x, map_y, o_image.data_[color], method, border);
+}
+
+
+} //namespace viennacv
@@ -0,0 +1,620 @@
+#pragma once
+/* =========================================================================
+   Copyright (c) 2016-2019, Department of Engineering Physics,
+                            Tsinghua University, Beijing, China.
+
+   Portions of this software are copyright by UChicago Argonne, LLC and ViennaCL team.
+
+                            -----------------
+                  ViennaCV - The Vienna Computer Vision Library
+                            -----------------
+
+   Project Head:    Wenyin Wei                   weiwy16@mails.tsinghua.edu.cn
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacv/io/image_io.hpp
+    @brief Implementation of memory-mapped readers and writers of binary PGM/PPM, PFM and raw planar image files
+*/
+
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <utility>
+#include <initializer_list>
+#include <exception>
+#include <type_traits>
+
+#if !defined(_WIN32) && !defined(VIENNACV_NO_MMAP)
+  #define VIENNACV_WITH_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/image_operations.hpp"
+#include "viennacv/core/image.hpp"
+#include "viennacv/core/image_enum.hpp"
+
+
+// SECTION 01 Mapped files
+namespace viennacv
+{
+namespace io
+{
+
+/** @brief Exception for files which cannot be opened, mapped, parsed or written */
+class io_exception : public std::exception
+{
+public:
+    io_exception() : message_() {}
+    io_exception(const std::string & message) : message_("ViennaCV: I/O error: " + message) {}
+
+    virtual const char* what() const throw() { return message_.c_str(); }
+
+    virtual ~io_exception() throw() {}
+private:
+    std::string message_;
+};
+
+/** @brief A whole file mapped into memory, unmapped on destruction. Move-only.
+ *
+ * Files opened for reading are mapped copy-on-write unless write_through is set, so pixels wrapped by an image may be modified without changing the file.
+ * Without mmap (Windows, or VIENNACV_NO_MMAP defined) the file is read into an owned buffer instead, and written back on destruction if it was created
+ * or opened with write_through.
+ */
+class mapped_file
+{
+public:
+    // SECTION 01_001 Constructor & Destructor
+    mapped_file() : data_(nullptr), size_(0), write_back_(false) {}
+
+    /** @brief Map an existing file
+     * @param  {std::string} path    : File name
+     * @param  {bool} write_through  : Whether writes to the mapped memory go to the file
+     */
+    explicit mapped_file(const std::string & path, bool write_through = false)
+        : data_(nullptr), size_(0), write_back_(false)
+    {
+#ifdef VIENNACV_WITH_MMAP
+        int fd = ::open(path.c_str(), write_through ? O_RDWR : O_RDONLY);
+        if (fd < 0)
+            throw io_exception("cannot open " + path);
+        struct stat t_stat;
+        if (::fstat(fd, &t_stat) != 0)
+        {
+            ::close(fd);
+            throw io_exception("cannot stat " + path);
+        }
+        map(fd, (size_t)t_stat.st_size, write_through ? MAP_SHARED : MAP_PRIVATE, path);
+#else
+        std::FILE * t_file = std::fopen(path.c_str(), "rb");
+        if (!t_file)
+            throw io_exception("cannot open " + path);
+        std::fseek(t_file, 0, SEEK_END);
+        buffer_.resize((size_t)std::ftell(t_file));
+        std::fseek(t_file, 0, SEEK_SET);
+        bool l_ok = std::fread(buffer_.data(), 1, buffer_.size(), t_file) == buffer_.size();
+        std::fclose(t_file);
+        if (!l_ok)
+            throw io_exception("cannot read " + path);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        path_ = path;
+        write_back_ = write_through;
+#endif
+    }
+
+    /** @brief Create (or truncate) a file of l_size bytes and map it for writing */
+    static mapped_file create(const std::string & path, size_t l_size)
+    {
+        mapped_file t_file;
+#ifdef VIENNACV_WITH_MMAP
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw io_exception("cannot create " + path);
+        if (::ftruncate(fd, (off_t)l_size) != 0)
+        {
+            ::close(fd);
+            throw io_exception("cannot resize " + path);
+        }
+        t_file.map(fd, l_size, MAP_SHARED, path);
+#else
+        t_file.buffer_.resize(l_size);
+        t_file.data_ = t_file.buffer_.data();
+        t_file.size_ = l_size;
+        t_file.path_ = path;
+        t_file.write_back_ = true;
+#endif
+        return t_file;
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file & operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file && i_file) noexcept
+        : data_(i_file.data_), size_(i_file.size_), buffer_(std::move(i_file.buffer_)), path_(std::move(i_file.path_)), write_back_(i_file.write_back_)
+    {
+        i_file.data_ = nullptr;
+        i_file.size_ = 0;
+        i_file.write_back_ = false;
+    }
+
+    mapped_file & operator=(mapped_file && i_file) noexcept
+    {
+        if (this != &i_file)
+        {
+            close();
+            std::swap(data_, i_file.data_);
+            std::swap(size_, i_file.size_);
+            buffer_.swap(i_file.buffer_);
+            path_.swap(i_file.path_);
+            std::swap(write_back_, i_file.write_back_);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { close(); }
+
+    // SECTION 01_002 Access
+    unsigned char * data()             { return data_; }
+    const unsigned char * data() const { return data_; }
+    size_t size() const                { return size_; }
+
+    /** @brief Unmap the file, writing it back first without mmap. Pointers into the mapping become invalid. */
+    void close()
+    {
+        if (!data_)
+            return;
+#ifdef VIENNACV_WITH_MMAP
+        if (size_ > 0)
+            ::munmap(data_, size_);
+#else
+        if (write_back_)
+            flush();
+        buffer_.clear();
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        write_back_ = false;
+    }
+
+protected:
+#ifdef VIENNACV_WITH_MMAP
+    void map(int fd, size_t l_size, int l_flags, const std::string & path)
+    {
+        if (l_size > 0)
+        {
+            void * t_data = ::mmap(nullptr, l_size, PROT_READ | PROT_WRITE, l_flags, fd, 0);
+            if (t_data == MAP_FAILED)
+            {
+                ::close(fd);
+                throw io_exception("cannot map " + path);
+            }
+            data_ = static_cast<unsigned char *>(t_data);
+        }
+        size_ = l_size;
+        ::close(fd);    // the mapping keeps the file open
+    }
+#else
+    void flush()
+    {
+        std::FILE * t_file = std::fopen(path_.c_str(), "wb");
+        if (t_file)
+        {
+            std::fwrite(buffer_.data(), 1, buffer_.size(), t_file);
+            std::fclose(t_file);
+        }
+    }
+#endif
+
+    unsigned char *             data_;
+    size_t                      size_;
+    std::vector<unsigned char>  buffer_;        // Only used without mmap
+    std::string                 path_;          // Only used without mmap
+    bool                        write_back_;    // Only used without mmap
+}; //class viennacv::io::mapped_file
+
+
+// SECTION 02 File formats
+enum image_file_type
+{
+    FILE_RAW,   // Planar samples without header
+    FILE_PGM,   // Binary portable graymap (P5), 8 or 16-bit big-endian samples
+    FILE_PPM,   // Binary portable pixmap (P6), interleaved RGB, 8 or 16-bit big-endian samples
+    FILE_PFM    // Portable float map (Pf gray, PF RGB), 32-bit float samples, rows stored bottom-up
+};
+
+/** @brief Layout of the pixels of an image file: sample (c, i, j) is at first_offset + c * channel_stride + i * row_stride + j * column_stride */
+struct image_file_info
+{
+    image_file_type type        = FILE_RAW;
+    size_t color_num            = 0;
+    size_t row_num              = 0;
+    size_t column_num           = 0;
+    size_t sample_size          = 1;        // Bytes per sample
+    double full_scale           = 255;      // Sample value of full intensity: maxval, 1 for PFM
+    bool   little_endian        = false;    // Byte order of multi-byte samples
+    size_t data_offset          = 0;        // Bytes before the first sample
+
+    /** @brief Bytes of all samples, 0 if any dimension is 0. Throws io_exception if the count does not fit in size_t, as from a hostile header. */
+    size_t data_size() const
+    {
+        size_t l_size = 1;
+        for (size_t factor: {color_num, row_num, column_num, sample_size})
+        {
+            if (factor == 0)
+                return 0;
+            if (l_size > SIZE_MAX / factor)
+                throw io_exception("the image size overflows");
+            l_size *= factor;
+        }
+        return l_size;
+    }
+
+    /** @brief Whether a file of l_size bytes holds the header and all samples, without overflowing data_offset + data_size() */
+    bool fits_in(size_t l_size) const { return (data_offset <= l_size) && (data_size() <= l_size - data_offset); }
+
+    /** @brief Byte offset of the sample of channel 0 at pixel (0, 0) */
+    long first_offset() const
+    {
+        if (type == FILE_PFM)       // bottom-up: image row 0 is the last row of the file
+            return (long)(data_offset + (row_num - 1) * column_num * color_num * sample_size);
+        return (long)data_offset;
+    }
+
+    long channel_stride() const { return (long)(((type == FILE_RAW) ? row_num * column_num : 1) * sample_size); }
+
+    long row_stride() const
+    {
+        long l_stride = (long)(column_num * ((type == FILE_RAW) ? 1 : color_num) * sample_size);
+        return (type == FILE_PFM) ? -l_stride : l_stride;
+    }
+
+    long column_stride() const { return (long)(((type == FILE_RAW) ? 1 : color_num) * sample_size); }
+};
+
+namespace detail
+{
+inline bool host_is_little_endian()
+{
+    const uint16_t l_one = 1;
+    unsigned char l_byte;
+    std::memcpy(&l_byte, &l_one, 1);
+    return l_byte == 1;
+}
+
+/** @brief Next token of a PNM/PFM header, skipping whitespace and comments. Advances pos past the token. */
+inline std::string next_header_token(const unsigned char * data, size_t l_size, size_t & pos)
+{
+    while (pos < l_size)
+    {
+        if (data[pos] == '#')
+            while ((pos < l_size) && (data[pos] != '\n') && (data[pos] != '\r'))
+                pos++;
+        else if (std::isspace(data[pos]))
+            pos++;
+        else
+            break;
+    }
+    std::string t_token;
+    while ((pos < l_size) && !std::isspace(data[pos]) && (data[pos] != '#'))
+        t_token.push_back((char)data[pos++]);
+    if (t_token.empty())
+        throw io_exception("truncated image header");
+    return t_token;
+}
+
+inline size_t parse_header_size(const std::string & token)
+{
+    char * t_end = nullptr;
+    unsigned long long l_value = std::strtoull(token.c_str(), &t_end, 10);
+    if (*t_end != '\0' || token[0] == '-')
+        throw io_exception("bad image header entry " + token);
+    return (size_t)l_value;
+}
+
+/** @brief Samples of an image file as pixels of the channels, scaled from the full scale of the file to the pixel range, in one pass over the file */
+template <typename NumericT>
+void import_channels(const unsigned char * data, const image_file_info & info, double scale, const std::vector<viennacl::matrix_base<NumericT> *> & o_channels)
+{
+    bool l_swap = (info.sample_size > 1) && (info.little_endian != host_is_little_endian());
+    const unsigned char * t_first = data + info.first_offset();
+    if (info.type == FILE_PFM)
+        viennacl::linalg::host_based::import_samples<float>(t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap, o_channels);
+    else if (info.type == FILE_RAW)
+        viennacl::linalg::host_based::import_samples<NumericT>(t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap, o_channels);
+    else if (info.sample_size == 2)
+        viennacl::linalg::host_based::import_samples<uint16_t>(t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap, o_channels);
+    else
+        viennacl::linalg::host_based::import_samples<uint8_t>(t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap, o_channels);
+}
+
+template <typename NumericT>
+void export_channels(const std::vector<viennacl::matrix_base<NumericT> const *> & i_channels, const image_file_info & info, double scale, unsigned char * data)
+{
+    bool l_swap = (info.sample_size > 1) && (info.little_endian != host_is_little_endian());
+    unsigned char * t_first = data + info.first_offset();
+    if (info.type == FILE_PFM)
+        viennacl::linalg::host_based::export_samples<float>(i_channels, t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap);
+    else if (info.type == FILE_RAW)
+        viennacl::linalg::host_based::export_samples<NumericT>(i_channels, t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap);
+    else if (info.sample_size == 2)
+        viennacl::linalg::host_based::export_samples<uint16_t>(i_channels, t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap);
+    else
+        viennacl::linalg::host_based::export_samples<uint8_t>(i_channels, t_first, info.channel_stride(), info.row_stride(), info.column_stride(), scale, l_swap);
+}
+
+/** @brief Channels of a host memory image of at least one channel, as the pointers the host kernels take */
+template <typename NumericT>
+std::vector<viennacl::matrix_base<NumericT> const *> host_channels(const viennacv::image_colpre<NumericT> & i_image)
+{
+    std::vector<viennacl::matrix_base<NumericT> const *> t_channels;
+    for (auto & channel: i_image.data_)
+    {
+        if (viennacl::traits::active_handle_id(channel) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        t_channels.push_back(&channel);
+    }
+    if (t_channels.empty())
+        throw io_exception("the image has no channel");
+    return t_channels;
+}
+} //namespace viennacv::io::detail
+
+// SECTION 02_001 Headers
+/** @brief Parse the header of a binary PGM (P5), PPM (P6) or PFM (Pf, PF) file and check that the file holds all pixels
+ * @param  {unsigned char *} data : File content
+ * @param  {size_t} l_size        : File size in bytes
+ * @return {image_file_info}      : Size and pixel layout
+ */
+inline image_file_info parse_image_header(const unsigned char * data, size_t l_size)
+{
+    image_file_info t_info;
+    if ((l_size < 2) || (data[0] != 'P'))
+        throw io_exception("not a PGM, PPM or PFM file");
+    switch (data[1])
+    {
+        case '5': t_info.type = FILE_PGM; t_info.color_num = 1; break;
+        case '6': t_info.type = FILE_PPM; t_info.color_num = 3; break;
+        case 'f': t_info.type = FILE_PFM; t_info.color_num = 1; break;
+        case 'F': t_info.type = FILE_PFM; t_info.color_num = 3; break;
+        default: throw io_exception("unsupported PNM variant P" + std::string(1, (char)data[1]) + ", only binary P5, P6, Pf and PF are read");
+    }
+    size_t pos = 2;
+    t_info.column_num = detail::parse_header_size(detail::next_header_token(data, l_size, pos));
+    t_info.row_num    = detail::parse_header_size(detail::next_header_token(data, l_size, pos));
+    std::string t_last = detail::next_header_token(data, l_size, pos);
+    if (t_info.type == FILE_PFM)
+    {
+        // NOTE The scale factor only carries the byte order: negative for little-endian.
+        double l_scale = std::strtod(t_last.c_str(), nullptr);
+        if (l_scale == 0)
+            throw io_exception("bad PFM scale " + t_last);
+        t_info.little_endian = l_scale < 0;
+        t_info.sample_size = 4;
+        t_info.full_scale = 1;
+    }
+    else
+    {
+        size_t l_maxval = detail::parse_header_size(t_last);
+        if ((l_maxval == 0) || (l_maxval > 65535))
+            throw io_exception("bad maxval " + t_last);
+        t_info.sample_size = (l_maxval < 256) ? 1 : 2;
+        t_info.full_scale = (double)l_maxval;
+        t_info.little_endian = false;
+    }
+    if ((pos >= l_size) || !std::isspace(data[pos]))
+        throw io_exception("truncated image header");
+    t_info.data_offset = pos + 1;       // exactly one whitespace byte before the samples
+    if ((t_info.data_size() == 0) || !t_info.fits_in(l_size))
+        throw io_exception("the file is smaller than its header says");
+    return t_info;
+}
+
+/** @brief Layout of a raw planar file of l_color_num channels of l_row_num x l_column_num samples of NumericT in host byte order, after l_offset header bytes */
+template <typename NumericT>
+image_file_info raw_image_info(size_t l_color_num, size_t l_row_num, size_t l_column_num, size_t l_offset = 0)
+{
+    image_file_info t_info;
+    t_info.type = FILE_RAW;
+    t_info.color_num = l_color_num;
+    t_info.row_num = l_row_num;
+    t_info.column_num = l_column_num;
+    t_info.sample_size = sizeof(NumericT);
+    t_info.full_scale = viennacl::linalg::host_based::detail::pixel_range<NumericT>();
+    t_info.little_endian = detail::host_is_little_endian();
+    t_info.data_offset = l_offset;
+    if (t_info.data_size() == 0)
+        throw io_exception("empty image");
+    return t_info;
+}
+
+
+// SECTION 03 Reading
+/** @brief Copy the pixels of a mapped image file into an image, in a single pass over the file straight into the channel memory, rows being distributed over threads.
+ *
+ * Samples are scaled from the full scale of the file (maxval, 1 for PFM) to the pixel range of NumericT (the maximum for integers, 1 for floating point), so
+ * an 8-bit file read into unsigned char pixels, or a PFM file read into float pixels, is copied exactly.
+ *
+ * @param  {mapped_file} i_file             : Mapped file
+ * @param  {image_file_info} info           : Layout of the file, see parse_image_header and raw_image_info
+ * @param  {image_colpre<NumericT>} o_image : Output image, resized if necessary. Its channels must live in host memory.
+ */
+template <typename NumericT>
+void read_image(const mapped_file & i_file, const image_file_info & info, viennacv::image_colpre<NumericT> & o_image)
+{
+    if (info.data_size() == 0)
+        throw io_exception("empty image");
+    if (!info.fits_in(i_file.size()))
+        throw io_exception("the file is smaller than the image");
+    o_image.data_.resize(info.color_num);
+    o_image.image_format_ = (info.color_num == 1) ? Gray : RGB;
+    std::vector<viennacl::matrix_base<NumericT> *> t_channels;
+    for (auto & channel: o_image.data_)
+    {
+        if ((channel.size1() != info.row_num) || (channel.size2() != info.column_num))
+            channel.resize(info.row_num, info.column_num, false);
+        if (viennacl::traits::active_handle_id(channel) != viennacl::MAIN_MEMORY)
+            throw viennacl::memory_exception("not implemented");
+        t_channels.push_back(&channel);
+    }
+    detail::import_channels(i_file.data(), info, viennacl::linalg::host_based::detail::pixel_range<NumericT>() / info.full_scale, t_channels);
+}
+
+/** @brief Read a binary PGM, PPM or PFM file into an image, see read_image(mapped_file, image_file_info, image_colpre) */
+template <typename NumericT>
+void read_image(const std::string & path, viennacv::image_colpre<NumericT> & o_image)
+{
+    mapped_file t_file(path);
+    read_image(t_file, parse_image_header(t_file.data(), t_file.size()), o_image);
+}
+
+/** @brief Read a raw planar file of NumericT samples in host byte order into an image, see raw_image_info */
+template <typename NumericT>
+void read_raw_image(const std::string & path, size_t l_color_num, size_t l_row_num, size_t l_column_num, viennacv::image_colpre<NumericT> & o_image, size_t l_offset = 0)
+{
+    mapped_file t_file(path);
+    read_image(t_file, raw_image_info<NumericT>(l_color_num, l_row_num, l_column_num, l_offset), o_image);
+}
+
+
+// SECTION 04 Zero-copy mapped images
+/** @brief An image whose channels are the mapped pixels of a file, without any copy. Move-only.
+ *
+ * Only files holding planar, aligned samples of NumericT in host byte order qualify: raw planar files, and 8-bit PGM files (maxval 255) read as 1-byte
+ * pixels. The others throw io_exception and must be read with read_image. The pixels are mapped copy-on-write unless write_through is set, in which case
+ * changes to the image are written to the file.
+ *
+ * @tparam NumericT : Pixel type
+ *
+ * @example
+ * viennacv::io::mapped_image<unsigned char> frame("frame_0001.pgm");
+ * blur.apply(frame.image(), blurred);
+ */
+template <typename NumericT>
+class mapped_image
+{
+public:
+    // SECTION 04_001 Constructor
+    /** @brief Map an 8-bit PGM file */
+    explicit mapped_image(const std::string & path, bool write_through = false)
+        : file_(path, write_through), info_(parse_image_header(file_.data(), file_.size())), image_(wrap(file_, info_))
+    {
+    }
+
+    /** @brief Map a raw planar file, see raw_image_info */
+    mapped_image(const std::string & path, size_t l_color_num, size_t l_row_num, size_t l_column_num, size_t l_offset = 0, bool write_through = false)
+        : file_(path, write_through), info_(raw_image_info<NumericT>(l_color_num, l_row_num, l_column_num, l_offset)), image_(wrap(file_, info_))
+    {
+    }
+
+    mapped_image(mapped_image && i_image) = default;
+    mapped_image & operator=(mapped_image && i_image) = default;
+
+    // SECTION 04_002 Access
+    /** @brief The image wrapping the mapped pixels, valid as long as this object */
+    viennacv::image_colpre<NumericT> & image()             { return image_; }
+    const viennacv::image_colpre<NumericT> & image() const { return image_; }
+    const image_file_info & info() const                   { return info_; }
+
+protected:
+    static viennacv::image_colpre<NumericT> wrap(mapped_file & i_file, const image_file_info & info)
+    {
+        bool l_planar = (info.type == FILE_RAW) || ((info.type == FILE_PGM) && (info.full_scale == viennacl::linalg::host_based::detail::pixel_range<NumericT>()));
+        if (!l_planar || (info.sample_size != sizeof(NumericT)) || (info.sample_size > 1 && info.little_endian != detail::host_is_little_endian()))
+            throw io_exception("the file does not hold planar samples of the pixel type, use read_image");
+        if ((info.data_offset % alignof(NumericT)) != 0)
+            throw io_exception("the samples of the file are not aligned, use read_image");
+        if (info.data_size() == 0)
+            throw io_exception("empty image");
+        if (!info.fits_in(i_file.size()))
+            throw io_exception("the file is smaller than the image");
+        viennacv::image_colpre<NumericT> t_image(reinterpret_cast<NumericT *>(i_file.data() + info.data_offset), info.color_num, info.row_num, info.column_num);
+        t_image.image_format_ = (info.color_num == 1) ? Gray : RGB;
+        return t_image;
+    }
+
+    // NOTE The file is declared first, so it is unmapped after the image wrapping it is destroyed.
+    mapped_file                         file_;
+    image_file_info                     info_;
+    viennacv::image_colpre<NumericT>    image_;
+}; //class viennacv::io::mapped_image
+
+
+// SECTION 05 Writing
+/** @brief Layout of the file write_image stores an image in: PGM (1 channel) or PPM (3 channels) for integer pixels, 8-bit for 1-byte pixels and 16-bit
+ *  otherwise, and PFM for floating point pixels */
+template <typename NumericT>
+image_file_info image_file_info_for(const viennacv::image_colpre<NumericT> & i_image)
+{
+    image_file_info t_info;
+    t_info.color_num = i_image.get_color_num();
+    if ((t_info.color_num != 1) && (t_info.color_num != 3))
+        throw io_exception("PGM, PPM and PFM files hold 1 or 3 channels");
+    t_info.row_num = i_image.get_row_num();
+    t_info.column_num = i_image.get_column_num();
+    if (std::is_floating_point<NumericT>::value)
+    {
+        t_info.type = FILE_PFM;
+        t_info.sample_size = 4;
+        t_info.full_scale = 1;
+        t_info.little_endian = detail::host_is_little_endian();
+    }
+    else
+    {
+        t_info.type = (t_info.color_num == 1) ? FILE_PGM : FILE_PPM;
+        t_info.sample_size = (sizeof(NumericT) == 1) ? 1 : 2;
+        t_info.full_scale = (sizeof(NumericT) == 1) ? 255 : 65535;
+        t_info.little_endian = false;
+    }
+    return t_info;
+}
+
+/** @brief Write an image to a binary PGM, PPM or PFM file through a writable mapping in a single pass, rows being distributed over threads.
+ *  Pixels are scaled from the pixel range of NumericT to the full scale of the file, see image_file_info_for.
+ * @param  {std::string} path                : File name, overwritten if it exists
+ * @param  {image_colpre<NumericT>} i_image  : Image of 1 or 3 channels in host memory
+ */
+template <typename NumericT>
+void write_image(const std::string & path, const viennacv::image_colpre<NumericT> & i_image)
+{
+    std::vector<viennacl::matrix_base<NumericT> const *> t_channels = detail::host_channels(i_image);
+    image_file_info t_info = image_file_info_for(i_image);
+    char t_header[96];
+    if (t_info.type == FILE_PFM)
+        std::snprintf(t_header, sizeof(t_header), "P%c\n%zu %zu\n%s\n", (t_info.color_num == 1) ? 'f' : 'F', t_info.column_num, t_info.row_num,
+                      t_info.little_endian ? "-1.0" : "1.0");
+    else
+        std::snprintf(t_header, sizeof(t_header), "P%c\n%zu %zu\n%u\n", (t_info.color_num == 1) ? '5' : '6', t_info.column_num, t_info.row_num,
+                      (unsigned int)t_info.full_scale);
+    t_info.data_offset = std::strlen(t_header);
+
+    mapped_file t_file = mapped_file::create(path, t_info.data_offset + t_info.data_size());
+    std::memcpy(t_file.data(), t_header, t_info.data_offset);
+    detail::export_channels(t_channels, t_info, t_info.full_scale / viennacl::linalg::host_based::detail::pixel_range<NumericT>(), t_file.data());
+}
+
+/** @brief Write an image to a raw planar file of NumericT samples in host byte order, without header, see read_raw_image */
+template <typename NumericT>
+void write_raw_image(const std::string & path, const viennacv::image_colpre<NumericT> & i_image)
+{
+    std::vector<viennacl::matrix_base<NumericT> const *> t_channels = detail::host_channels(i_image);
+    image_file_info t_info = raw_image_info<NumericT>(i_image.get_color_num(), i_image.get_row_num(), i_image.get_column_num());
+    mapped_file t_file = mapped_file::create(path, t_info.data_size());
+    detail::export_channels(t_channels, t_info, 1.0, t_file.data());
+}
+
+
+} //namespace viennacv::io
+} //namespace viennacv